@@ -0,0 +1,79 @@
+import argparse
+import os
+
+import numpy as np
+import onnx
+from PIL import Image
+from onnxruntime.quantization import CalibrationDataReader, CalibrationMethod, QuantFormat, QuantType, \
+    quantize_static
+
+# Parse arguments
+ap = argparse.ArgumentParser()
+ap.add_argument("-i", "--input", required=True, help="path to the FP32 .onnx model (yoloModel.onnxpath)")
+ap.add_argument("-o", "--output", required=True, help="path to the INT8 .onnx model (yoloModel.onnxint8path)")
+ap.add_argument("-c", "--calibration", required=True, help="path to folder containing calibration images "
+                                                           "(e.g. data/training-photos/original)")
+ap.add_argument("-n", "--max-images", default="0", help="maximum number of calibration images (0 = all)")
+ap.add_argument("-s", "--input-size", default="416", help="input size used when the model has a dynamic size")
+ap.add_argument("-x", "--exclude-nodes", default="", help="comma-separated names of the nodes to keep in FP32 "
+                                                          "(e.g. the last layers that decode the boxes)")
+args = vars(ap.parse_args())
+
+inputModelPath = args["input"]
+outputModelPath = args["output"]
+calibrationFolderPath = args["calibration"]
+maxImages = int(args["max_images"])
+defaultInputSize = int(args["input_size"])
+nodesToExclude = [nodeName for nodeName in args["exclude_nodes"].split(",") if nodeName]
+
+# Find the input of the model (NCHW)
+model = onnx.load(inputModelPath)
+initializerNames = {initializer.name for initializer in model.graph.initializer}
+modelInput = next(modelInput for modelInput in model.graph.input if modelInput.name not in initializerNames)
+inputDims = [dim.dim_value if dim.dim_value > 0 else -1 for dim in modelInput.type.tensor_type.shape.dim]
+inputHeight = inputDims[2] if inputDims[2] > 0 else defaultInputSize
+inputWidth = inputDims[3] if inputDims[3] > 0 else defaultInputSize
+print(f"Model input: {modelInput.name} {inputDims}, images resized to {inputWidth}x{inputHeight}")
+
+
+class TrainingPhotosDataReader(CalibrationDataReader):
+    """
+    Feed the calibration images to the model, prepared like the frames of the video in the application:
+    squeezed to the input size, converted to planar RGB and scaled to [0, 1].
+    """
+
+    def __init__(self, imagePaths):
+        self.imagePaths = iter(imagePaths)
+
+    def get_next(self):
+        imagePath = next(self.imagePaths, None)
+        if imagePath is None:
+            return None
+        print(f"Calibrate with the image: {os.path.basename(imagePath)}")
+        image = Image.open(imagePath).convert("RGB").resize((inputWidth, inputHeight), Image.BILINEAR)
+        pixels = np.asarray(image, dtype=np.float32) / 255.0
+        return {modelInput.name: pixels.transpose(2, 0, 1)[np.newaxis, ...]}
+
+
+# Find the calibration images
+imageNames = sorted(imageName for imageName in os.listdir(calibrationFolderPath)
+                    if imageName.lower().endswith((".jpg", ".jpeg", ".png")))
+if maxImages > 0:
+    imageNames = imageNames[:maxImages]
+print(f"Quantize the model with {len(imageNames)} calibration images...")
+
+# Weights are quantized per channel and activations per tensor, with QuantizeLinear / DequantizeLinear
+# nodes (QDQ format) that OpenCV 4.7+ converts into INT8 layers
+quantize_static(
+    inputModelPath,
+    outputModelPath,
+    TrainingPhotosDataReader([os.path.join(calibrationFolderPath, imageName) for imageName in imageNames]),
+    quant_format=QuantFormat.QDQ,
+    activation_type=QuantType.QInt8,
+    weight_type=QuantType.QInt8,
+    per_channel=True,
+    calibrate_method=CalibrationMethod.MinMax,
+    nodes_to_exclude=nodesToExclude)
+
+print(f"INT8 model written into: {outputModelPath} "
+      f"({os.path.getsize(inputModelPath) >> 20} MB -> {os.path.getsize(outputModelPath) >> 20} MB)")
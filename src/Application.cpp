@@ -1,12 +1,11 @@
 #include "utils/logging.hpp"
+#include "utils/JpegArchive.hpp"
 #include "utils/ProgramArgumentsParser.hpp"
 #include "ApplicationContext.hpp"
 
 using namespace model;
 using namespace service;
 using namespace utils;
-using std::list;
-using std::vector;
 namespace lg = boost::log;
 
 int main(int argc, char* argv[]) {
@@ -21,63 +20,47 @@ int main(int argc, char* argv[]) {
     } catch (std::runtime_error e) {
         return 1;
     }
+
+    // Extract frames from a JPEG archive if requested
+    if (!programArguments.extractArchivePath.empty()) {
+        LOG_INFO(logger) << "Extract the frames from " << programArguments.extractArchivePath.string()
+            << " into " << programArguments.extractOutputPath.string() << "...";
+        JpegArchiveReader jpegArchiveReader(programArguments.extractArchivePath.string());
+        int nbExtractedFrames = jpegArchiveReader.extractFrames(
+            programArguments.extractOutputPath,
+            programArguments.extractFirstFrameIndex,
+            programArguments.extractLastFrameIndex);
+        LOG_INFO(logger) << nbExtractedFrames << " frames extracted with success!";
+        return 0;
+    }
+
     LOG_INFO(logger) << "Initialization (configuration path = " << programArguments.configurationPath.string()
         << ", video path = " << programArguments.videoPath.string() << ")...";
 
     // Initialize the application context
-    ApplicationContext applicationContext(programArguments.configurationPath, programArguments.videoPath);
-    auto& videoProperties = applicationContext.getVideoProperties();
-    auto& videoFrameReader = applicationContext.getVideoFrameReader();
-    auto& objectDetector = applicationContext.getObjectDetector();
-    auto& trackerTip = applicationContext.getTrackerTip();
-    auto& trackerChopstick = applicationContext.getTrackerChopstick();
-    auto& videoFrameWriter = applicationContext.getVideoFrameWriter();
-    auto& videoFramePainterImage = applicationContext.getVideoFramePainterImage();
-    auto& videoFramePainterDetectedObjects = applicationContext.getVideoFramePainterDetectedObjects();
-    auto& videoFramePainterTrackedObjects = applicationContext.getVideoFramePainterTrackedObjects();
-
-    // Detect and track objects in the video
-    LOG_INFO(logger) << "Detect and track objects in the video...";
-    FrameOffset accumulatedFrameOffset(0, 0);
-    vector<DetectedObject> detectedObjects;
-    vector<DetectedObject> prevFrameDetectedObjects;
-    list<Tip> tips;
-    list<Chopstick> chopsticks;
-    cv::Mat outputFrame = videoFrameWriter.buildOutputFrame();
-
-    for (int frameIndex = 0; frameIndex < videoProperties.nbFrames; frameIndex++) {
-        LOG_INFO(logger) << "Processing the frame " << frameIndex
-            << "/" << (videoProperties.nbFrames - 1) << "...";
-
-        // Read the next frame
-        auto frame = videoFrameReader.readFrameAt(frameIndex);
+    ApplicationContext applicationContext(programArguments);
 
-        // Detect the objects in this frame
-        prevFrameDetectedObjects = detectedObjects;
-        detectedObjects = objectDetector.detectObjectsAt(frameIndex);
-
-        // Find how much we need to compensate for camera motion
-        FrameOffset frameOffset(0, 0);
-        if (frameIndex >= 1) {
-            frameOffset = trackerTip.computeOffsetToCompensateForCameraMotion(
-                prevFrameDetectedObjects, detectedObjects);
-            accumulatedFrameOffset += frameOffset;
-        }
-
-        // Update the tracked tips and chopsticks
-        trackerTip.updateTipsWithNewDetectionResult(
-            tips, detectedObjects, frameIndex, frameOffset, accumulatedFrameOffset);
-
-        trackerChopstick.updateChopsticksWithNewDetectionResult(
-            chopsticks, tips, detectedObjects, accumulatedFrameOffset);
-
-        // Render the detected and tracked objects in an output video frame
-        videoFramePainterImage.paintOnFrame(outputFrame, frame, accumulatedFrameOffset);
-        videoFramePainterDetectedObjects.paintOnFrame(outputFrame, detectedObjects, accumulatedFrameOffset);
-        videoFramePainterTrackedObjects.paintOnFrame(outputFrame, tips, chopsticks, accumulatedFrameOffset);
+    // Report the progress of the worker processes if requested
+    if (programArguments.executionMode == ExecutionMode::DETECT_COORDINATOR) {
+        auto& frameRangeLeases = applicationContext.getFrameRangeLeases();
+        int nbReleasedLeases = frameRangeLeases.releaseStaleLeases();
+        LOG_INFO(logger) << "Detection progress: " << frameRangeLeases.describeProgress()
+            << " (" << nbReleasedLeases << " stale leases released).";
+        return 0;
+    }
 
-        videoFrameWriter.writeFrameAt(frameIndex, outputFrame);
+    // Detect and track objects in the video
+    auto& videoProcessor = applicationContext.getVideoProcessor();
+    if (programArguments.executionMode == ExecutionMode::CALIBRATE_DETECTOR) {
+        LOG_INFO(logger) << "Calibrate the object detector...";
+    } else if (programArguments.executionMode == ExecutionMode::COMPARE_DETECTORS) {
+        LOG_INFO(logger) << "Compare the object detector with the reference implementation...";
+    } else if (programArguments.executionMode != ExecutionMode::PROCESS_VIDEO) {
+        LOG_INFO(logger) << "Detect objects in the video...";
+    } else {
+        LOG_INFO(logger) << "Detect and track objects in the video...";
     }
+    videoProcessor.processVideo();
 
     LOG_INFO(logger) << "Application executed with success!";
 
@@ -1,78 +1,330 @@
 #ifndef APPLICATION_CONTEXT
 #define APPLICATION_CONTEXT
 
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include <boost/filesystem.hpp>
+#include <opencv2/opencv.hpp>
+#include "model/ProgramArguments.hpp"
+#include "utils/KeyframeIndex.hpp"
+#include "utils/logging.hpp"
 #include "service/impl/ConfigurationReaderImpl.hpp"
 #include "service/impl/ObjectDetectorCacheImpl.hpp"
 #include "service/impl/ObjectDetectorDarknetImpl.hpp"
+#include "service/impl/ObjectDetectorMotionGateImpl.hpp"
+#include "service/impl/ObjectDetectorOnnxImpl.hpp"
 #include "service/impl/ObjectDetectorOpenCvDnnImpl.hpp"
+#include "service/impl/ObjectDetectorPoolImpl.hpp"
+#include "service/impl/ObjectDetectorPropagationImpl.hpp"
+#include "service/impl/RegionOfInterestDetectorImpl.hpp"
 #include "service/impl/TrackerTipImpl.hpp"
 #include "service/impl/TrackerChopstickImpl.hpp"
 #include "service/impl/VideoFramePainterImageImpl.hpp"
 #include "service/impl/VideoFramePainterDetectedObjectsImpl.hpp"
 #include "service/impl/VideoFramePainterTrackedObjectsImpl.hpp"
 #include "service/impl/VideoFrameReaderImpl.hpp"
+#include "service/impl/VideoFrameReaderPrefetchImpl.hpp"
+#include "service/impl/VideoFrameWriterAsyncImpl.hpp"
 #include "service/impl/VideoFrameWriterMjpgImpl.hpp"
+#include "service/impl/VideoFrameWriterMjpgParallelImpl.hpp"
+#include "service/impl/VideoFrameWriterMultiJpegArchiveImpl.hpp"
 #include "service/impl/VideoFrameWriterMultiJpegImpl.hpp"
+#include "service/impl/VideoFrameWriterReorderImpl.hpp"
+#include "service/impl/VideoProcessorCalibrateDetectorImpl.hpp"
+#include "service/impl/VideoProcessorCompareDetectorsImpl.hpp"
+#include "service/impl/VideoProcessorDetectOnlyImpl.hpp"
+#include "service/impl/VideoProcessorDetectWorkerImpl.hpp"
+#include "service/impl/VideoProcessorPipelineImpl.hpp"
+#include "service/impl/VideoProcessorSequentialImpl.hpp"
 
 class ApplicationContext {
     private:
+        static constexpr int DEFAULT_MAX_DETECT_ONLY_NB_SEGMENTS = 4;
+
+        boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
         model::Configuration configuration;
         model::VideoProperties videoProperties;
+        utils::KeyframeIndex keyframeIndex;
 
         std::unique_ptr<service::ConfigurationReader> pConfigurationReaderImpl;
         std::unique_ptr<service::VideoFrameReader> pVideoFrameReaderImpl;
+        std::vector<std::unique_ptr<service::ObjectDetector>> replicaObjectDetectors;
         std::unique_ptr<service::ObjectDetector> pInnerObjectDetector;
-        std::unique_ptr<service::ObjectDetector> pObjectDetectorCacheImpl;
+        std::unique_ptr<service::ObjectDetector> pReferenceObjectDetector;
+        std::unique_ptr<service::ObjectDetectorCacheImpl> pObjectDetectorCacheImpl;
+        std::unique_ptr<service::ObjectDetector> pObjectDetectorMotionGateImpl;
+        std::unique_ptr<service::ObjectDetector> pObjectDetectorPropagationImpl;
+        std::unique_ptr<service::RegionOfInterestDetector> pRegionOfInterestDetectorImpl;
         std::unique_ptr<service::TrackerTip> pTrackerTipImpl;
         std::unique_ptr<service::TrackerChopstick> pTrackerChopstickImpl;
+        std::unique_ptr<service::VideoFrameWriter> pInnerVideoFrameWriter;
+        std::unique_ptr<service::VideoFrameWriter> pAsyncVideoFrameWriter;
         std::unique_ptr<service::VideoFrameWriter> pVideoFrameWriter;
         std::unique_ptr<service::VideoFramePainterImage> pVideoFramePainterImageImpl;
         std::unique_ptr<service::VideoFramePainterDetectedObjects> pVideoFramePainterDetectedObjectsImpl;
         std::unique_ptr<service::VideoFramePainterTrackedObjects> pVideoFramePainterTrackedObjectsImpl;
+        std::vector<std::unique_ptr<service::VideoFrameReader>> segmentVideoFrameReaders;
+        std::vector<std::unique_ptr<service::ObjectDetector>> segmentInnerObjectDetectors;
+        std::vector<std::unique_ptr<service::ObjectDetector>> segmentObjectDetectors;
+        std::unique_ptr<utils::FrameRangeLeases> pFrameRangeLeases;
+        std::unique_ptr<service::VideoProcessor> pVideoProcessor;
 
     public:
-        ApplicationContext(boost::filesystem::path& configurationPath, boost::filesystem::path& videoPath) {
+        ApplicationContext(model::ProgramArguments& programArguments) {
+            boost::filesystem::path& configurationPath = programArguments.configurationPath;
+            boost::filesystem::path& videoPath = programArguments.videoPath;
+            model::ExecutionMode executionMode = programArguments.executionMode;
+
             // Configuration
+            auto startupStartTime = std::chrono::steady_clock::now();
             pConfigurationReaderImpl.reset(new service::ConfigurationReaderImpl());
             configuration = pConfigurationReaderImpl->read(configurationPath);
+            checkConfiguration();
+            double configurationDurationMs = getDurationMsSince(startupStartTime);
+
+            // Objects detection (the detect-only and calibration modes have their own neural networks, the
+            // coordinator does not detect anything)
+            bool isNeuralNetworkUsed = executionMode == model::ExecutionMode::PROCESS_VIDEO
+                || executionMode == model::ExecutionMode::DETECT_WORKER
+                || executionMode == model::ExecutionMode::COMPARE_DETECTORS;
+            if (isNeuralNetworkUsed && configuration.objectDetectionNbReplicas > 1) {
+                // Each replica has its own neural network
+                std::vector<service::ObjectDetector*> replicas;
+                for (int i = 0; i < configuration.objectDetectionNbReplicas; i++) {
+                    replicaObjectDetectors.emplace_back(newNeuralNetworkObjectDetector());
+                    replicas.push_back(replicaObjectDetectors.back().get());
+                }
+                pInnerObjectDetector.reset(new service::ObjectDetectorPoolImpl(configuration, replicas));
+            } else if (isNeuralNetworkUsed) {
+                pInnerObjectDetector.reset(newNeuralNetworkObjectDetector());
+
+                // Note: this setting is global to OpenCV, with several replicas it is set by the pool
+                if (configuration.objectDetectionNbThreadsPerReplica > 0) {
+                    cv::setNumThreads(configuration.objectDetectionNbThreadsPerReplica);
+                }
+            }
+            if (executionMode == model::ExecutionMode::PROCESS_VIDEO
+                || executionMode == model::ExecutionMode::DETECT_WORKER) {
+                pObjectDetectorCacheImpl.reset(new service::ObjectDetectorCacheImpl(
+                    configuration, *pInnerObjectDetector, videoPath));
+            }
 
-            // Video reader
-            pVideoFrameReaderImpl.reset(new service::VideoFrameReaderImpl(configuration, videoPath));
+            // When rendering, the neural network can be skipped on static frames and between keyframes
+            service::ObjectDetector* pRenderingObjectDetector = pObjectDetectorCacheImpl.get();
+            if (executionMode == model::ExecutionMode::PROCESS_VIDEO) {
+                if (configuration.objectDetectionMotionGateMaxDifference > 0) {
+                    pObjectDetectorMotionGateImpl.reset(new service::ObjectDetectorMotionGateImpl(
+                        configuration, *pRenderingObjectDetector));
+                    pRenderingObjectDetector = pObjectDetectorMotionGateImpl.get();
+                }
+                if (configuration.objectDetectionKeyframeInterval > 1) {
+                    pObjectDetectorPropagationImpl.reset(new service::ObjectDetectorPropagationImpl(
+                        configuration, *pRenderingObjectDetector));
+                    pRenderingObjectDetector = pObjectDetectorPropagationImpl.get();
+                }
+                if (configuration.objectDetectionRoiFullFramePeriod > 0) {
+                    pRegionOfInterestDetectorImpl.reset(new service::RegionOfInterestDetectorImpl(
+                        configuration, *pRenderingObjectDetector, *pInnerObjectDetector));
+                }
+            }
+
+            // Prepare the output folder in a background thread while the video is opened (eager initialization)
+            bool isEagerInitialization = configuration.processingEagerInitialization
+                && (executionMode == model::ExecutionMode::PROCESS_VIDEO
+                    || executionMode == model::ExecutionMode::DETECT_WORKER);
+            std::future<double> warmUpDurationMsFuture;
+            std::future<double> outputPreparationDurationMsFuture;
+            if (isEagerInitialization && executionMode == model::ExecutionMode::PROCESS_VIDEO) {
+                outputPreparationDurationMsFuture = std::async(std::launch::async, [this] {
+                    auto outputPreparationStartTime = std::chrono::steady_clock::now();
+                    boost::filesystem::create_directories(configuration.renderingOutputPath);
+                    return getDurationMsSince(outputPreparationStartTime);
+                });
+            }
+
+            // Video reader (the keyframe index is stored next to the cached detection results)
+            auto videoOpeningStartTime = std::chrono::steady_clock::now();
+            keyframeIndex = utils::KeyframeIndex::loadOrBuild(
+                videoPath, configuration.objectDetectionCacheFolderPath / videoPath.filename() / "keyframes.txt");
+            pVideoFrameReaderImpl.reset(newVideoFrameReader(videoPath));
             videoProperties = pVideoFrameReaderImpl->getVideoProperties();
+            double videoOpeningDurationMs = getDurationMsSince(videoOpeningStartTime);
 
-            // Objects detection
-            if (configuration.objectDetectionImplementation == "darknet") {
-                pInnerObjectDetector.reset(new service::ObjectDetectorDarknetImpl(
-                    configuration, *pVideoFrameReaderImpl, videoProperties));
-            } else if (configuration.objectDetectionImplementation == "opencvdnn") {
-                pInnerObjectDetector.reset(new service::ObjectDetectorOpenCvDnnImpl(
-                    configuration, *pVideoFrameReaderImpl, videoProperties));
+            // Frames to process
+            int firstFrameIndex = std::max(0, programArguments.startFrameIndex);
+            int endFrameIndex = videoProperties.nbFrames;
+            if (programArguments.endFrameIndex >= 0) {
+                endFrameIndex = std::min(endFrameIndex, programArguments.endFrameIndex + 1);
+            }
+            if (firstFrameIndex >= endFrameIndex) {
+                throw std::runtime_error("No frame to process between --start-frame and --end-frame.");
             }
-            pObjectDetectorCacheImpl.reset(new service::ObjectDetectorCacheImpl(
-                configuration, *pInnerObjectDetector, videoPath));
 
-            // Objects tracking
-            pTrackerTipImpl.reset(new service::TrackerTipImpl(configuration));
-            pTrackerChopstickImpl.reset(new service::TrackerChopstickImpl(configuration));
+            // Load the neural network in a background thread while the other components are created (eager
+            // initialization), unless the detected objects of all the frames are cached already (the regions of
+            // interest are not cached)
+            if (isEagerInitialization && !pRegionOfInterestDetectorImpl
+                && pObjectDetectorCacheImpl->isCached(firstFrameIndex, endFrameIndex)) {
+                LOG_INFO(logger) << "All the frames are cached, the neural network is not loaded in advance.";
+            } else if (isEagerInitialization) {
+                warmUpDurationMsFuture = std::async(std::launch::async, [this] {
+                    auto warmUpStartTime = std::chrono::steady_clock::now();
+                    pInnerObjectDetector->warmUp();
+                    return getDurationMsSince(warmUpStartTime);
+                });
+            }
+
+            // Tracking and rendering (only needed when the video is processed, the writers allocate their
+            // buffers and start their encoding threads when they are created)
+            if (executionMode == model::ExecutionMode::PROCESS_VIDEO) {
+                // Objects tracking
+                pTrackerTipImpl.reset(new service::TrackerTipImpl(configuration));
+                pTrackerChopstickImpl.reset(new service::TrackerChopstickImpl(configuration));
+
+                // Video writer
+                if (configuration.renderingWriterImplementation == "mjpeg") {
+                    pInnerVideoFrameWriter.reset(new service::VideoFrameWriterMjpgImpl(
+                        configuration, videoPath, videoProperties));
+                } else if (configuration.renderingWriterImplementation == "mjpeg-parallel") {
+                    pInnerVideoFrameWriter.reset(new service::VideoFrameWriterMjpgParallelImpl(
+                        configuration, videoPath, videoProperties));
+                } else if (configuration.renderingWriterImplementation == "multijpeg") {
+                    pInnerVideoFrameWriter.reset(new service::VideoFrameWriterMultiJpegImpl(
+                        configuration, videoPath, videoProperties));
+                } else if (configuration.renderingWriterImplementation == "multijpeg-archive") {
+                    pInnerVideoFrameWriter.reset(new service::VideoFrameWriterMultiJpegArchiveImpl(
+                        configuration, videoPath, videoProperties));
+                }
+                if (configuration.renderingAsyncWriterPoolSize > 0) {
+                    pAsyncVideoFrameWriter.reset(new service::VideoFrameWriterAsyncImpl(
+                        configuration, *pInnerVideoFrameWriter));
+                } else {
+                    pAsyncVideoFrameWriter = std::move(pInnerVideoFrameWriter);
+                }
+                if (configuration.renderingReorderWindowSize > 0) {
+                    pVideoFrameWriter.reset(new service::VideoFrameWriterReorderImpl(
+                        configuration, *pAsyncVideoFrameWriter));
+                } else {
+                    pVideoFrameWriter = std::move(pAsyncVideoFrameWriter);
+                }
+
+                // Video painters
+                pVideoFramePainterImageImpl.reset(
+                    new service::VideoFramePainterImageImpl(configuration));
+                pVideoFramePainterDetectedObjectsImpl.reset(
+                    new service::VideoFramePainterDetectedObjectsImpl(configuration));
+                pVideoFramePainterTrackedObjectsImpl.reset(
+                    new service::VideoFramePainterTrackedObjectsImpl(configuration));
+            }
+
+            // Video processor
+            if (executionMode == model::ExecutionMode::DETECT_WORKER
+                || executionMode == model::ExecutionMode::DETECT_COORDINATOR) {
+                // The leases are stored next to the cached detection results
+                pFrameRangeLeases.reset(new utils::FrameRangeLeases(
+                    configuration.objectDetectionCacheFolderPath / videoPath.filename() / "leases",
+                    videoProperties.nbFrames,
+                    configuration.processingWorkerFrameRangeSize,
+                    configuration.processingWorkerLeaseTimeoutInSeconds));
+            }
+            if (executionMode == model::ExecutionMode::DETECT_WORKER) {
+                pVideoProcessor.reset(new service::VideoProcessorDetectWorkerImpl(
+                    configuration, *pVideoFrameReaderImpl, *pObjectDetectorCacheImpl, *pFrameRangeLeases));
+            } else if (executionMode == model::ExecutionMode::CALIBRATE_DETECTOR) {
+                pVideoProcessor.reset(new service::VideoProcessorCalibrateDetectorImpl(
+                    configuration,
+                    firstFrameIndex,
+                    endFrameIndex,
+                    *pVideoFrameReaderImpl,
+                    configurationPath.parent_path() / "detector-calibration.ini"));
+            } else if (executionMode == model::ExecutionMode::COMPARE_DETECTORS) {
+                // The reference is the FP32 YOLO model, without cache
+                pReferenceObjectDetector.reset(new service::ObjectDetectorOpenCvDnnImpl(configuration));
+                pVideoProcessor.reset(new service::VideoProcessorCompareDetectorsImpl(
+                    configuration,
+                    firstFrameIndex,
+                    endFrameIndex,
+                    *pVideoFrameReaderImpl,
+                    *pReferenceObjectDetector,
+                    *pInnerObjectDetector,
+                    configurationPath.parent_path() / "detector-comparison.txt"));
+            } else if (executionMode == model::ExecutionMode::DETECT_ONLY) {
+                // Each segment of the video has its own reader, neural network and cache
+                int nbSegments = configuration.processingDetectOnlyNbSegments;
+                if (nbSegments <= 0) {
+                    // Each neural network takes hundreds of MB, so the default number of segments is bounded
+                    nbSegments = std::max(1, std::min(
+                        DEFAULT_MAX_DETECT_ONLY_NB_SEGMENTS, (int) std::thread::hardware_concurrency()));
+                }
+                if (configuration.objectDetectionImplementation == "darknet") {
+                    nbSegments = 1;
+                }
+
+                std::vector<service::VideoFrameReader*> videoFrameReaders;
+                std::vector<service::ObjectDetector*> objectDetectors;
+                for (int i = 0; i < nbSegments; i++) {
+                    segmentVideoFrameReaders.emplace_back(newVideoFrameReader(videoPath));
+                    videoFrameReaders.push_back(segmentVideoFrameReaders.back().get());
+                    segmentInnerObjectDetectors.emplace_back(newNeuralNetworkObjectDetector());
+                    segmentObjectDetectors.emplace_back(new service::ObjectDetectorCacheImpl(
+                        configuration, *segmentInnerObjectDetectors.back(), videoPath));
+                    objectDetectors.push_back(segmentObjectDetectors.back().get());
+                }
 
-            // Video writer
-            if (configuration.renderingWriterImplementation == "mjpeg") {
-                pVideoFrameWriter.reset(new service::VideoFrameWriterMjpgImpl(
-                    configuration, videoPath, videoProperties));
-            } else if (configuration.renderingWriterImplementation == "multijpeg") {
-                pVideoFrameWriter.reset(new service::VideoFrameWriterMultiJpegImpl(
-                    configuration, videoPath, videoProperties));
+                pVideoProcessor.reset(new service::VideoProcessorDetectOnlyImpl(
+                    configuration, firstFrameIndex, endFrameIndex, videoFrameReaders, objectDetectors));
+            } else if (executionMode == model::ExecutionMode::PROCESS_VIDEO
+                && configuration.processingExecutor == "sequential") {
+                pVideoProcessor.reset(new service::VideoProcessorSequentialImpl(
+                    configuration,
+                    videoProperties,
+                    firstFrameIndex,
+                    endFrameIndex,
+                    *pVideoFrameReaderImpl,
+                    *pRenderingObjectDetector,
+                    *pTrackerTipImpl,
+                    *pTrackerChopstickImpl,
+                    *pVideoFramePainterImageImpl,
+                    *pVideoFramePainterDetectedObjectsImpl,
+                    *pVideoFramePainterTrackedObjectsImpl,
+                    *pVideoFrameWriter,
+                    pRegionOfInterestDetectorImpl.get()));
+            } else if (executionMode == model::ExecutionMode::PROCESS_VIDEO
+                && configuration.processingExecutor == "pipeline") {
+                pVideoProcessor.reset(new service::VideoProcessorPipelineImpl(
+                    configuration,
+                    videoProperties,
+                    firstFrameIndex,
+                    endFrameIndex,
+                    *pVideoFrameReaderImpl,
+                    *pRenderingObjectDetector,
+                    *pTrackerTipImpl,
+                    *pTrackerChopstickImpl,
+                    *pVideoFramePainterImageImpl,
+                    *pVideoFramePainterDetectedObjectsImpl,
+                    *pVideoFramePainterTrackedObjectsImpl,
+                    *pVideoFrameWriter));
             }
 
-            // Video painters
-            pVideoFramePainterImageImpl.reset(
-                new service::VideoFramePainterImageImpl(configuration));
-            pVideoFramePainterDetectedObjectsImpl.reset(
-                new service::VideoFramePainterDetectedObjectsImpl(configuration));
-            pVideoFramePainterTrackedObjectsImpl.reset(
-                new service::VideoFramePainterTrackedObjectsImpl(configuration));
+            // Wait for the background initialization and report the startup time
+            std::stringstream startupReport;
+            startupReport << "Startup: configuration = " << configurationDurationMs
+                << " ms, video opening = " << videoOpeningDurationMs << " ms";
+            if (outputPreparationDurationMsFuture.valid()) {
+                startupReport << ", output preparation = " << outputPreparationDurationMsFuture.get() << " ms";
+            }
+            if (warmUpDurationMsFuture.valid()) {
+                startupReport << ", neural network loading and warm-up = " << warmUpDurationMsFuture.get() << " ms";
+            }
+            startupReport << ", total = " << getDurationMsSince(startupStartTime) << " ms.";
+            LOG_INFO(logger) << startupReport.str();
         }
 
         const model::Configuration& getConfiguration() const {
@@ -91,33 +343,129 @@ class ApplicationContext {
             return *pVideoFrameReaderImpl;
         }
 
+        /**
+         * Only available with the PROCESS_VIDEO and DETECT_WORKER execution modes.
+         */
         service::ObjectDetector& getObjectDetector() const {
             return *pObjectDetectorCacheImpl;
         }
 
+        /**
+         * Only available with the PROCESS_VIDEO execution mode.
+         */
         const service::TrackerTip& getTrackerTip() const {
             return *pTrackerTipImpl;
         }
 
+        /**
+         * Only available with the PROCESS_VIDEO execution mode.
+         */
         const service::TrackerChopstick& getTrackerChopstick() const {
             return *pTrackerChopstickImpl;
         }
 
+        /**
+         * Only available with the PROCESS_VIDEO execution mode.
+         */
         service::VideoFrameWriter& getVideoFrameWriter() const {
             return *pVideoFrameWriter;
         }
 
+        /**
+         * Only available with the PROCESS_VIDEO execution mode.
+         */
         const service::VideoFramePainterImage& getVideoFramePainterImage() const {
             return *pVideoFramePainterImageImpl;
         }
 
+        /**
+         * Only available with the PROCESS_VIDEO execution mode.
+         */
         const service::VideoFramePainterDetectedObjects& getVideoFramePainterDetectedObjects() const {
             return *pVideoFramePainterDetectedObjectsImpl;
         }
 
+        /**
+         * Only available with the PROCESS_VIDEO execution mode.
+         */
         const service::VideoFramePainterTrackedObjects& getVideoFramePainterTrackedObjects() const {
             return *pVideoFramePainterTrackedObjectsImpl;
         }
+
+        /**
+         * Only available with the execution modes other than DETECT_COORDINATOR.
+         */
+        service::VideoProcessor& getVideoProcessor() const {
+            return *pVideoProcessor;
+        }
+
+        /**
+         * Only available with the DETECT_WORKER and DETECT_COORDINATOR execution modes.
+         */
+        const utils::FrameRangeLeases& getFrameRangeLeases() const {
+            return *pFrameRangeLeases;
+        }
+
+    private:
+        static double getDurationMsSince(std::chrono::steady_clock::time_point startTime) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        }
+
+        service::VideoFrameReader* newVideoFrameReader(boost::filesystem::path& videoPath) const {
+            if (configuration.inputVideoPrefetchDepth > 0) {
+                return new service::VideoFrameReaderPrefetchImpl(configuration, videoPath, keyframeIndex);
+            }
+            return new service::VideoFrameReaderImpl(configuration, videoPath, keyframeIndex);
+        }
+
+        service::ObjectDetector* newNeuralNetworkObjectDetector() const {
+            if (configuration.objectDetectionImplementation == "darknet") {
+                return new service::ObjectDetectorDarknetImpl(configuration);
+            }
+            if (configuration.objectDetectionImplementation == "onnx") {
+                return new service::ObjectDetectorOnnxImpl(configuration, configuration.yoloModelOnnxPath, false);
+            }
+            if (configuration.objectDetectionImplementation == "onnx-int8") {
+                return new service::ObjectDetectorOnnxImpl(configuration, configuration.yoloModelOnnxInt8Path, true);
+            }
+            return new service::ObjectDetectorOpenCvDnnImpl(configuration);
+        }
+
+        void checkConfiguration() const {
+            const std::string& implementation = configuration.objectDetectionImplementation;
+            if (implementation != "opencvdnn" && implementation != "darknet" && implementation != "onnx"
+                && implementation != "onnx-int8") {
+                throw std::runtime_error("Unknown objectDetection.implementation: " + implementation);
+            }
+            if (configuration.objectDetectionNbReplicas > 1 && implementation == "darknet") {
+                throw std::runtime_error(
+                    "objectDetection.nbReplicas is not supported by the \"darknet\" implementation.");
+            }
+            if (configuration.objectDetectionMotionGateMaxDifference > 0
+                && (configuration.objectDetectionMotionGateScale <= 0 || configuration.objectDetectionMotionGateScale > 1)) {
+                throw std::runtime_error("objectDetection.motionGateScale must be greater than 0 and at most 1.");
+            }
+            // The pipeline detects the objects of a frame before the previous ones are tracked
+            if (configuration.objectDetectionRoiFullFramePeriod > 0 && configuration.processingExecutor == "pipeline") {
+                throw std::runtime_error(
+                    "objectDetection.roiFullFramePeriod is only supported by the \"sequential\" executor.");
+            }
+
+            int nbPaintingThreads = configuration.processingExecutor == "pipeline"
+                ? configuration.processingPipelineNbPaintingThreads : 1;
+            if (nbPaintingThreads > 1 && configuration.renderingReorderWindowSize < nbPaintingThreads) {
+                throw std::runtime_error(
+                    "rendering.reorderWindowSize must be at least equal to processing.pipelineNbPaintingThreads.");
+            }
+
+            // Frames waiting in the reorder window keep their buffer, so the missing frame needs another one
+            if (configuration.renderingAsyncWriterPoolSize > 0 && configuration.renderingReorderWindowSize > 0
+                && configuration.renderingAsyncWriterPoolSize
+                    <= configuration.renderingReorderWindowSize + nbPaintingThreads) {
+                throw std::runtime_error("rendering.asyncWriterPoolSize must be greater than "
+                    "rendering.reorderWindowSize + the number of painting threads.");
+            }
+        }
 };
 
 #endif // APPLICATION_CONTEXT
\ No newline at end of file
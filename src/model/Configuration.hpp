@@ -13,8 +13,13 @@ namespace model {
             std::vector<std::string> yoloModelClassNames;
             boost::filesystem::path yoloModelCfgPath;
             boost::filesystem::path yoloModelWeightsPath;
+            boost::filesystem::path yoloModelOnnxPath;
+            boost::filesystem::path yoloModelOnnxInt8Path;
+            std::string yoloModelOnnxOutputLayout;
+            int yoloModelOnnxInputSize;
 
             bool inputVideoCrop;
+            int inputVideoPrefetchDepth;
 
             float objectDetectionMinTipConfidence;
             float objectDetectionMinChopstickConfidence;
@@ -22,6 +27,23 @@ namespace model {
             float objectDetectionNmsThreshold;
             std::string objectDetectionImplementation;
             boost::filesystem::path objectDetectionCacheFolderPath;
+            int objectDetectionBatchSize;
+            int objectDetectionNbReplicas;
+            int objectDetectionNbThreadsPerReplica;
+            std::string objectDetectionDnnBackend;
+            std::string objectDetectionDnnTarget;
+            int objectDetectionCalibrationNbFrames;
+            int objectDetectionComparisonNbFrames;
+            int objectDetectionKeyframeInterval;
+            double objectDetectionPropagationScale;
+            double objectDetectionPropagationMinTrackedRatio;
+            double objectDetectionMotionGateMaxDifference;
+            int objectDetectionMotionGateMaxConsecutiveSkips;
+            double objectDetectionMotionGateScale;
+            int objectDetectionRoiFullFramePeriod;
+            int objectDetectionRoiMinWindowSize;
+            double objectDetectionRoiWindowScale;
+            int objectDetectionRoiMaxWindows;
 
             int trackingMaxTipMatchingDistanceInPixels;
             int trackingNbTipsToUseToDetectCameraMotion;
@@ -44,6 +66,17 @@ namespace model {
             bool renderingTrackedObjectsPainterShowChopstickArrows;
             std::string renderingWriterImplementation;
             int renderingVideoFrameMarginsInPixels;
+            int renderingNbEncodingThreads;
+            int renderingAsyncWriterPoolSize;
+            int renderingReorderWindowSize;
+
+            std::string processingExecutor;
+            bool processingEagerInitialization;
+            int processingPipelineQueueCapacity;
+            int processingPipelineNbPaintingThreads;
+            int processingDetectOnlyNbSegments;
+            int processingWorkerFrameRangeSize;
+            int processingWorkerLeaseTimeoutInSeconds;
         
         public:
             Configuration() {}
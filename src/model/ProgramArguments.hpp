@@ -1,14 +1,38 @@
 #ifndef MODEL_PROGRAM_ARGUMENTS
 #define MODEL_PROGRAM_ARGUMENTS
 
+#include <limits>
 #include <boost/filesystem.hpp>
 
 namespace model {
 
+    enum class ExecutionMode {
+        // Detect and track objects, then render the output video
+        PROCESS_VIDEO,
+        // Fill the object detection cache with several threads
+        DETECT_ONLY,
+        // Fill the object detection cache together with other processes
+        DETECT_WORKER,
+        // Report the progress of the worker processes and release their stale leases
+        DETECT_COORDINATOR,
+        // Measure the speed of the object detector with each backend, target and number of threads
+        CALIBRATE_DETECTOR,
+        // Compare the latency and the detections of the object detector with the reference implementation
+        COMPARE_DETECTORS
+    };
+
     class ProgramArguments {
         public:
             boost::filesystem::path configurationPath;
             boost::filesystem::path videoPath;
+            ExecutionMode executionMode = ExecutionMode::PROCESS_VIDEO;
+            int startFrameIndex = 0;
+            int endFrameIndex = -1; // Inclusive, -1 = last frame of the video
+
+            boost::filesystem::path extractArchivePath;
+            boost::filesystem::path extractOutputPath;
+            int extractFirstFrameIndex = 0;
+            int extractLastFrameIndex = std::numeric_limits<int>::max();
         
         public:
             ProgramArguments() {}
@@ -18,4 +42,4 @@ namespace model {
     };
 }
 
-#endif // MODEL_PROGRAM_ARGUMENTS
\ No newline at end of file
+#endif // MODEL_PROGRAM_ARGUMENTS
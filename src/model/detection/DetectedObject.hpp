@@ -11,6 +11,8 @@ namespace model {
         public:
             DetectedObjectType objectType = DetectedObjectType::CHOPSTICK;
             float confidence = 0.0;
+            // True when the object was not detected by the neural network but moved from a previous frame
+            bool isPropagated = false;
 
         public:
             DetectedObject() : Rectangle() {}
@@ -27,7 +29,9 @@ namespace model {
                     confidence(confidence) {}
 
             const DetectedObject copyAndTranslate(double dx, double dy) const {
-                return DetectedObject(x + dx, y + dy, width, height, objectType, confidence);
+                DetectedObject translatedObject(x + dx, y + dy, width, height, objectType, confidence);
+                translatedObject.isPropagated = isPropagated;
+                return translatedObject;
             }
 
             bool operator== (const DetectedObject& other) const {
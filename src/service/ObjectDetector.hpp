@@ -2,6 +2,7 @@
 #define SERVICE_OBJECT_DETECTOR
 
 #include <vector>
+#include <opencv2/opencv.hpp>
 #include "../model/detection/DetectedObject.hpp"
 
 namespace service {
@@ -10,9 +11,31 @@ namespace service {
         public:
             virtual ~ObjectDetector() {}
 
-            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex) = 0;
+            /**
+             * Detect the objects in the given frame, already decoded by the caller.
+             *
+             * @param frameIndex Index of the frame in the video (used to cache the results).
+             */
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame) = 0;
+
+            /**
+             * Detect the objects in several consecutive frames at once. This is faster than calling
+             * {@link #detectObjectsAt(int, const cv::Mat&)} for each frame when the implementation can
+             * process a batch of images in a single pass.
+             *
+             * @param firstFrameIndex Index of the first frame in the video (used to cache the results).
+             * @return One vector of detected objects per frame.
+             */
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames) = 0;
+
+            /**
+             * Load the neural network and run it once on a blank image, so that the first frames are not
+             * slowed down by the initialization.
+             */
+            virtual void warmUp() = 0;
     };
 
 }
 
-#endif // SERVICE_OBJECT_DETECTOR
\ No newline at end of file
+#endif // SERVICE_OBJECT_DETECTOR
@@ -0,0 +1,39 @@
+#ifndef SERVICE_REGION_OF_INTEREST_DETECTOR
+#define SERVICE_REGION_OF_INTEREST_DETECTOR
+
+#include <list>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "../model/detection/DetectedObject.hpp"
+#include "../model/tracking/Chopstick.hpp"
+#include "../model/tracking/FrameOffset.hpp"
+#include "../model/tracking/Tip.hpp"
+
+namespace service {
+
+    class RegionOfInterestDetector {
+        public:
+            virtual ~RegionOfInterestDetector() {}
+
+            /**
+             * Detect the objects in the given frame, by only looking around the tracked tips and chopsticks
+             * and the arms of the previous frame when possible.
+             *
+             * @param frameIndex Index of the frame in the video.
+             * @param tips Tracked tips (coordinates compensated for camera motion).
+             * @param chopsticks Tracked chopsticks.
+             * @param prevDetectedObjects Objects detected in the previous frame.
+             * @param accumulatedFrameOffset Camera motion between the first frame and the previous one.
+             */
+            virtual std::vector<model::DetectedObject> detectObjectsAt(
+                int frameIndex,
+                const cv::Mat& frame,
+                const std::list<model::Tip>& tips,
+                const std::list<model::Chopstick>& chopsticks,
+                const std::vector<model::DetectedObject>& prevDetectedObjects,
+                const model::FrameOffset accumulatedFrameOffset) = 0;
+    };
+
+}
+
+#endif // SERVICE_REGION_OF_INTEREST_DETECTOR
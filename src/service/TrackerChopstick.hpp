@@ -6,6 +6,7 @@
 #include "../model/detection/DetectedObject.hpp"
 #include "../model/tracking/FrameOffset.hpp"
 #include "../model/tracking/Chopstick.hpp"
+#include "../model/tracking/Tip.hpp"
 
 namespace service {
 
@@ -12,6 +12,23 @@ namespace service {
             virtual cv::Mat buildOutputFrame() = 0;
 
             virtual void writeFrameAt(int frameIndex, cv::Mat& frame) = 0;
+
+            /**
+             * Give back a frame returned by {@link #buildOutputFrame()} that will not be written
+             * (e.g. when it could not be painted).
+             */
+            virtual void discardOutputFrame(cv::Mat& frame) = 0;
+
+            /**
+             * Wait until all the frames given to {@link #writeFrameAt(int, cv::Mat&)} are written.
+             */
+            virtual void flush() = 0;
+
+            /**
+             * Stop writing frames after an error of the caller: the frames waiting to be written are dropped,
+             * and the threads blocked in this writer are woken up with an error.
+             */
+            virtual void cancel() = 0;
     };
 
 }
@@ -0,0 +1,18 @@
+#ifndef SERVICE_VIDEO_PROCESSOR
+#define SERVICE_VIDEO_PROCESSOR
+
+namespace service {
+
+    class VideoProcessor {
+        public:
+            virtual ~VideoProcessor() {}
+
+            /**
+             * Detect and track objects in all the frames of the video, and write the rendered frames.
+             */
+            virtual void processVideo() = 0;
+    };
+
+}
+
+#endif // SERVICE_VIDEO_PROCESSOR
@@ -32,8 +32,15 @@ Configuration ConfigurationReaderImpl::read(fs::path configurationPath) const {
     fs::path rootPath = configurationPath.parent_path();
     config.yoloModelCfgPath = fs::canonical(fs::path(rootPath / relativeYoloCfgPath));
     config.yoloModelWeightsPath = fs::canonical(fs::path(rootPath / relativeYoloWeightsPath));
+    fs::path relativeYoloOnnxPath(propTree.get<string>("yoloModel.onnxpath"));
+    config.yoloModelOnnxPath = fs::path(rootPath / relativeYoloOnnxPath);
+    fs::path relativeYoloOnnxInt8Path(propTree.get<string>("yoloModel.onnxint8path"));
+    config.yoloModelOnnxInt8Path = fs::path(rootPath / relativeYoloOnnxInt8Path);
+    config.yoloModelOnnxOutputLayout = propTree.get<string>("yoloModel.onnxoutputlayout");
+    config.yoloModelOnnxInputSize = propTree.get<int>("yoloModel.onnxinputsize");
 
     config.inputVideoCrop = propTree.get<bool>("inputVideo.crop");
+    config.inputVideoPrefetchDepth = propTree.get<int>("inputVideo.prefetchDepth");
 
     config.objectDetectionMinTipConfidence = propTree.get<float>("objectDetection.minTipConfidence");
     config.objectDetectionMinChopstickConfidence =
@@ -43,6 +50,25 @@ Configuration ConfigurationReaderImpl::read(fs::path configurationPath) const {
     config.objectDetectionImplementation = propTree.get<string>("objectDetection.implementation");
     fs::path relativeCacheFolderPath(propTree.get<string>("objectDetection.cacheFolderPath"));
     config.objectDetectionCacheFolderPath = fs::path(rootPath / relativeCacheFolderPath);
+    config.objectDetectionBatchSize = propTree.get<int>("objectDetection.batchSize");
+    config.objectDetectionNbReplicas = propTree.get<int>("objectDetection.nbReplicas");
+    config.objectDetectionNbThreadsPerReplica = propTree.get<int>("objectDetection.nbThreadsPerReplica");
+    config.objectDetectionDnnBackend = propTree.get<string>("objectDetection.dnnBackend");
+    config.objectDetectionDnnTarget = propTree.get<string>("objectDetection.dnnTarget");
+    config.objectDetectionCalibrationNbFrames = propTree.get<int>("objectDetection.calibrationNbFrames");
+    config.objectDetectionComparisonNbFrames = propTree.get<int>("objectDetection.comparisonNbFrames");
+    config.objectDetectionKeyframeInterval = propTree.get<int>("objectDetection.keyframeInterval");
+    config.objectDetectionPropagationScale = propTree.get<double>("objectDetection.propagationScale");
+    config.objectDetectionPropagationMinTrackedRatio =
+        propTree.get<double>("objectDetection.propagationMinTrackedRatio");
+    config.objectDetectionMotionGateMaxDifference = propTree.get<double>("objectDetection.motionGateMaxDifference");
+    config.objectDetectionMotionGateMaxConsecutiveSkips =
+        propTree.get<int>("objectDetection.motionGateMaxConsecutiveSkips");
+    config.objectDetectionMotionGateScale = propTree.get<double>("objectDetection.motionGateScale");
+    config.objectDetectionRoiFullFramePeriod = propTree.get<int>("objectDetection.roiFullFramePeriod");
+    config.objectDetectionRoiMinWindowSize = propTree.get<int>("objectDetection.roiMinWindowSize");
+    config.objectDetectionRoiWindowScale = propTree.get<double>("objectDetection.roiWindowScale");
+    config.objectDetectionRoiMaxWindows = propTree.get<int>("objectDetection.roiMaxWindows");
 
     config.trackingMaxTipMatchingDistanceInPixels =
         propTree.get<int>("tracking.maxTipMatchingDistanceInPixels");
@@ -83,6 +109,18 @@ Configuration ConfigurationReaderImpl::read(fs::path configurationPath) const {
         propTree.get<bool>("rendering.trackedObjectsPainter_showChopstickArrows");
     config.renderingWriterImplementation = propTree.get<string>("rendering.writerImplementation");
     config.renderingVideoFrameMarginsInPixels = propTree.get<int>("rendering.videoFrameMarginsInPixels");
+    config.renderingNbEncodingThreads = propTree.get<int>("rendering.nbEncodingThreads");
+    config.renderingAsyncWriterPoolSize = propTree.get<int>("rendering.asyncWriterPoolSize");
+    config.renderingReorderWindowSize = propTree.get<int>("rendering.reorderWindowSize");
+
+    config.processingExecutor = propTree.get<string>("processing.executor");
+    config.processingEagerInitialization = propTree.get<bool>("processing.eagerInitialization");
+    config.processingPipelineQueueCapacity = propTree.get<int>("processing.pipelineQueueCapacity");
+    config.processingPipelineNbPaintingThreads = propTree.get<int>("processing.pipelineNbPaintingThreads");
+    config.processingDetectOnlyNbSegments = propTree.get<int>("processing.detectOnlyNbSegments");
+    config.processingWorkerFrameRangeSize = propTree.get<int>("processing.workerFrameRangeSize");
+    config.processingWorkerLeaseTimeoutInSeconds =
+        propTree.get<int>("processing.workerLeaseTimeoutInSeconds");
 
     return config;
 }
@@ -2,12 +2,13 @@
 #include <rapidjson/document.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/prettywriter.h>
+#include "../../utils/AtomicFileWriter.hpp"
 #include "ObjectDetectorCacheImpl.hpp"
 
 using namespace model;
 using namespace service;
+using namespace utils;
 using std::ifstream;
-using std::ofstream;
 using std::string;
 using std::istreambuf_iterator;
 using std::to_string;
@@ -15,7 +16,83 @@ using std::vector;
 using std::runtime_error;
 namespace fs = boost::filesystem;
 
-vector<DetectedObject> ObjectDetectorCacheImpl::detectObjectsAt(int frameIndex) {
+vector<DetectedObject> ObjectDetectorCacheImpl::detectObjectsAt(int frameIndex, const cv::Mat& frame) {
+    fs::path cacheFolderPath = initCacheFolderIfNecessary();
+
+    // Check if the detected objects are cached already
+    string fileName = to_string(frameIndex) + ".json";
+    fs::path objectsPath(cacheFolderPath / fileName);
+    
+    if (fs::exists(objectsPath)) {
+        return readFromCache(objectsPath);
+    } else {
+        // Use the wrapped object detector to get the objects and serialize it
+        vector<DetectedObject> detectedObjects = wrappedObjectDetector.detectObjectsAt(frameIndex, frame);
+        writeToCache(objectsPath, detectedObjects);
+        return detectedObjects;
+    }
+}
+
+void ObjectDetectorCacheImpl::warmUp() {
+    wrappedObjectDetector.warmUp();
+}
+
+bool ObjectDetectorCacheImpl::isCached(int firstFrameIndex, int endFrameIndex) const {
+    fs::path cacheFolderPath(configuration.objectDetectionCacheFolderPath / videoPath.filename());
+    if (!fs::is_directory(cacheFolderPath)) {
+        return false;
+    }
+    for (int frameIndex = firstFrameIndex; frameIndex < endFrameIndex; frameIndex++) {
+        if (!fs::exists(cacheFolderPath / (to_string(frameIndex) + ".json"))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+vector<vector<DetectedObject>> ObjectDetectorCacheImpl::detectObjectsAt(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    fs::path cacheFolderPath = initCacheFolderIfNecessary();
+    int nbFrames = frames.size();
+    vector<vector<DetectedObject>> detectedObjectsByFrame(nbFrames);
+
+    int firstMissingFrameOffset = -1;
+    for (int frameOffset = 0; frameOffset <= nbFrames; frameOffset++) {
+        bool cached = false;
+        if (frameOffset < nbFrames) {
+            string fileName = to_string(firstFrameIndex + frameOffset) + ".json";
+            fs::path objectsPath(cacheFolderPath / fileName);
+            if (fs::exists(objectsPath)) {
+                detectedObjectsByFrame[frameOffset] = readFromCache(objectsPath);
+                cached = true;
+            } else if (firstMissingFrameOffset == -1) {
+                firstMissingFrameOffset = frameOffset;
+            }
+        }
+
+        // Send each sequence of consecutive cache misses to the wrapped object detector
+        if ((cached || frameOffset == nbFrames) && firstMissingFrameOffset != -1) {
+            int nbMissingFrames = frameOffset - firstMissingFrameOffset;
+            vector<cv::Mat> missingFrames(
+                frames.begin() + firstMissingFrameOffset, frames.begin() + frameOffset);
+            vector<vector<DetectedObject>> missingDetectedObjectsByFrame = wrappedObjectDetector.detectObjectsAt(
+                firstFrameIndex + firstMissingFrameOffset, missingFrames);
+
+            for (int i = 0; i < nbMissingFrames; i++) {
+                int missingFrameOffset = firstMissingFrameOffset + i;
+                string fileName = to_string(firstFrameIndex + missingFrameOffset) + ".json";
+                writeToCache(cacheFolderPath / fileName, missingDetectedObjectsByFrame[i]);
+                detectedObjectsByFrame[missingFrameOffset] = std::move(missingDetectedObjectsByFrame[i]);
+            }
+            firstMissingFrameOffset = -1;
+        }
+    }
+
+    return detectedObjectsByFrame;
+}
+
+fs::path ObjectDetectorCacheImpl::initCacheFolderIfNecessary() {
     fs::path rootCacheFolderPath = configuration.objectDetectionCacheFolderPath;
     fs::path cacheFolderPath(rootCacheFolderPath / videoPath.filename());
 
@@ -29,7 +106,8 @@ vector<DetectedObject> ObjectDetectorCacheImpl::detectObjectsAt(int frameIndex)
                     throw runtime_error("Unable to delete the file: " + cacheFolderPath.string());
                 }
             } else {
-                if (!fs::create_directories(cacheFolderPath)) {
+                // Note: another instance may create the same folder in parallel (--detect-only mode)
+                if (!fs::create_directories(cacheFolderPath) && !fs::is_directory(cacheFolderPath)) {
                     throw runtime_error("Unable to create the directory: " + cacheFolderPath.string());
                 }
             }
@@ -38,28 +116,24 @@ vector<DetectedObject> ObjectDetectorCacheImpl::detectObjectsAt(int frameIndex)
         cacheFolderInitialized = true;
     }
 
-    // Check if the detected objects are cached already
-    string fileName = to_string(frameIndex) + ".json";
-    fs::path objectsPath(cacheFolderPath / fileName);
-    
-    if (fs::exists(objectsPath)) {
-        // Unserialize the objects
-        ifstream objectsFile(objectsPath.string());
-        string detectedObjectsJson(
-            (istreambuf_iterator<char>(objectsFile)), istreambuf_iterator<char>());
-        objectsFile.close();
+    return cacheFolderPath;
+}
 
-        return convertFromJson(detectedObjectsJson);
-    } else {
-        // Use the wrapped object detector to get the objects and serialize it
-        vector<DetectedObject> detectedObjects = wrappedObjectDetector.detectObjectsAt(frameIndex);
-        
-        ofstream objectsFile(objectsPath.string());
-        objectsFile << convertToJson(detectedObjects);
-        objectsFile.close();
- 
-        return detectedObjects;
-    }
+void ObjectDetectorCacheImpl::writeToCache(
+    const fs::path& objectsPath, const vector<DetectedObject>& detectedObjects) {
+
+    // Other processes may read the cache at the same time, so they must never see a partial file
+    AtomicFileWriter::write(objectsPath, convertToJson(detectedObjects));
+}
+
+vector<DetectedObject> ObjectDetectorCacheImpl::readFromCache(const fs::path& objectsPath) {
+    // Unserialize the objects
+    ifstream objectsFile(objectsPath.string());
+    string detectedObjectsJson(
+        (istreambuf_iterator<char>(objectsFile)), istreambuf_iterator<char>());
+    objectsFile.close();
+
+    return convertFromJson(detectedObjectsJson);
 }
 
 std::string ObjectDetectorCacheImpl::convertToJson(std::vector<DetectedObject> detectedObjects) {
@@ -6,7 +6,6 @@
 #include "../../model/Configuration.hpp"
 #include "../../utils/logging.hpp"
 #include "../ObjectDetector.hpp"
-#include "../VideoFrameReader.hpp"
 
 namespace service {
 
@@ -38,9 +37,25 @@ namespace service {
 
             virtual ~ObjectDetectorCacheImpl() {}
 
-            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex);
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame);
+
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+            virtual void warmUp();
+
+            /**
+             * @return true if the detected objects of all the frames between firstFrameIndex (inclusive) and
+             *         endFrameIndex (exclusive) are cached, so the wrapped detector will not be used for them.
+             */
+            bool isCached(int firstFrameIndex, int endFrameIndex) const;
 
         private:
+            boost::filesystem::path initCacheFolderIfNecessary();
+            void writeToCache(
+                const boost::filesystem::path& objectsPath,
+                const std::vector<model::DetectedObject>& detectedObjects);
+            std::vector<model::DetectedObject> readFromCache(const boost::filesystem::path& objectsPath);
             std::string convertToJson(std::vector<model::DetectedObject> detectedObjects);
             std::vector<model::DetectedObject> convertFromJson(std::string detectedObjectsJson);
     };
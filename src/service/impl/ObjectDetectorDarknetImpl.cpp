@@ -1,7 +1,7 @@
 #include <algorithm>
 #include <math.h>
-#include "../../model/VideoProperties.hpp"
 #include "ObjectDetectorDarknetImpl.hpp"
+#include "../../utils/BgrToPlanarConverter.hpp"
 
 using namespace model;
 using namespace service;
@@ -10,126 +10,117 @@ using std::min;
 using std::string;
 using std::vector;
 
-vector<DetectedObject> ObjectDetectorDarknetImpl::detectObjectsAt(int frameIndex) {
-    cv::Mat frame = videoFrameReader.readFrameAt(frameIndex);
-
-    if (!pNeuralNetwork) {
-        LOG_INFO(logger) << "Loading the YOLO neural network model...";
-        pNeuralNetwork = std::unique_ptr<network>(load_network_custom(
-            (char*) configuration.yoloModelCfgPath.string().c_str(), 
-            (char*) configuration.yoloModelWeightsPath.string().c_str(), 
-            /*clear = */ 0,
-            /*batch = */ 1));
-        
-        lastLayer = pNeuralNetwork->layers[pNeuralNetwork->n - 1];
-        objectTypesByClassId = DetectedObjectTypeHelper::stringsToEnums(configuration.yoloModelClassNames);
-
-        minTipConfidence = configuration.objectDetectionMinTipConfidence;
-        minChopstickConfidence = configuration.objectDetectionMinChopstickConfidence;
-        minArmConfidence = configuration.objectDetectionMinArmConfidence;
-        minConfidence = min(minTipConfidence, min(minChopstickConfidence, minArmConfidence));
-    }
-
-    // Convert and resize the image for YOLO on Darknet
-    image frameImage = matToImage(frame);
-    image resizedImage = resize_image(frameImage, pNeuralNetwork->w, pNeuralNetwork->h);
-
-    // Detect objects
-    network_predict_image(pNeuralNetwork.get(), resizedImage);
-    int nbDetections = 0;
-    detection* detections = get_network_boxes(
-        pNeuralNetwork.get(),
-        pNeuralNetwork->w,
-        pNeuralNetwork->h,
-        minConfidence,
-        minConfidence,
-        /* map */0,
-        /* relative */1,
-        &nbDetections,
-        /* letter */0);
-    float nmsThreshold = configuration.objectDetectionNmsThreshold;
-    do_nms_sort(detections, nbDetections, lastLayer.classes, nmsThreshold);
-    
-    // Release image resources
-    free_image(resizedImage);
-    free_image(frameImage);
+vector<DetectedObject> ObjectDetectorDarknetImpl::detectObjectsAt(int frameIndex, const cv::Mat& frame) {
+    return detectObjectsAt(frameIndex, vector<cv::Mat>{ frame })[0];
+}
 
-    // Extract objects
-    vector<DetectedObject> detectedObjects;
-    for (int detectionIndex = 0; detectionIndex < nbDetections; detectionIndex++) {
-        detection detection = detections[detectionIndex];
-
-        // Find the detected class and confidence
-        int classId = -1;
-        float confidence = -1.0f;
-        for (int i = 0; i < detection.classes; i++) {
-            if (detection.prob[i] >= confidence) {
-                classId = i;
-                confidence = detection.prob[i];
-            }
+vector<vector<DetectedObject>> ObjectDetectorDarknetImpl::detectObjectsAt(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    initNeuralNetworkIfNecessary();
+
+    int inputSize = pNeuralNetwork->w * pNeuralNetwork->h * 3;
+    image inputImage;
+    inputImage.w = pNeuralNetwork->w;
+    inputImage.h = pNeuralNetwork->h;
+    inputImage.c = 3;
+    inputImage.data = networkInput.data();
+
+    vector<vector<DetectedObject>> detectedObjectsByFrame;
+    int nbFrames = frames.size();
+    for (int batchFirstFrameOffset = 0; batchFirstFrameOffset < nbFrames; batchFirstFrameOffset += batchSize) {
+        // Fill the network input with the frames of this batch (when the batch is incomplete, the
+        // remaining slots keep old data and their detections are ignored)
+        int nbBatchFrames = min(batchSize, nbFrames - batchFirstFrameOffset);
+        for (int i = 0; i < nbBatchFrames; i++) {
+            pInputPreprocessor->preprocess(
+                frames[batchFirstFrameOffset + i], networkInput.data() + i * inputSize);
         }
 
-        if (confidence >= minConfidence) {
-            DetectedObjectType objectType = objectTypesByClassId[classId];
-            
-            float minConfidenceForType = minConfidence;
-            switch (objectType) {
-                case DetectedObjectType::SMALL_TIP:
-                case DetectedObjectType::BIG_TIP:
-                    minConfidenceForType = minTipConfidence;
-                    break;
-                case DetectedObjectType::ARM:
-                    minConfidenceForType = minArmConfidence;
-                    break;
-                case DetectedObjectType::CHOPSTICK:
-                default:
-                    minConfidenceForType = minChopstickConfidence;
-                    break;
-            }
-
-            if (confidence >= minConfidenceForType) {
-                float centerX = detection.bbox.x * videoProperties.frameWidth;
-                float centerY = detection.bbox.y * videoProperties.frameHeight;
-                float width = detection.bbox.w * videoProperties.frameWidth;
-                float height = detection.bbox.h * videoProperties.frameHeight;
-                float x = centerX - (width / 2);
-                float y = centerY - (height / 2);
-
-                const DetectedObject detectedObject(
-                    x, y,
-                    width, height,
-                    objectType, 
-                    confidence);
-                detectedObjects.push_back(detectedObject);
-            }
+        // Detect objects
+        det_num_pair* batchDetections = network_predict_batch(
+            pNeuralNetwork.get(),
+            inputImage,
+            batchSize,
+            pNeuralNetwork->w,
+            pNeuralNetwork->h,
+            pOutputDecoder->getMinConfidence(),
+            pOutputDecoder->getMinConfidence(),
+            /* map */0,
+            /* relative */1,
+            /* letter */0);
+
+        for (int i = 0; i < nbBatchFrames; i++) {
+            int frameOffset = batchFirstFrameOffset + i;
+            detectedObjectsByFrame.push_back(suppressDuplicates(
+                firstFrameIndex + frameOffset,
+                extractDetectedObjects(batchDetections[i].dets, batchDetections[i].num, frames[frameOffset].size())));
         }
+
+        // Release the detections (they are allocated by Darknet for each prediction)
+        free_batch_detections(batchDetections, batchSize);
     }
 
-    // Release the remaining resources
-    free_detections(detections, nbDetections);
+    return detectedObjectsByFrame;
+}
 
-    return detectedObjects;
+void ObjectDetectorDarknetImpl::warmUp() {
+    initNeuralNetworkIfNecessary();
+
+    // Run the network once on its current (blank) input
+    image inputImage;
+    inputImage.w = pNeuralNetwork->w;
+    inputImage.h = pNeuralNetwork->h;
+    inputImage.c = 3;
+    inputImage.data = networkInput.data();
+    float minConfidence = pOutputDecoder->getMinConfidence();
+    det_num_pair* batchDetections = network_predict_batch(
+        pNeuralNetwork.get(), inputImage, batchSize, pNeuralNetwork->w, pNeuralNetwork->h,
+        minConfidence, minConfidence, /* map */0, /* relative */1, /* letter */0);
+    free_batch_detections(batchDetections, batchSize);
 }
 
-image ObjectDetectorDarknetImpl::matToImage(cv::Mat& src) {
-    int width = src.cols;
-    int height = src.rows;
-    int nbChannels = src.channels();
-    int step = src.step;
-
-    image dest = make_image(width, height, nbChannels);
-
-    for (int c = 0; c < nbChannels; c++) {
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                float pixelValue = src.data[y * step + x * nbChannels + c] / 255.0f;
-                int offset = c * width * height + y * width + x;
-                dest.data[offset] = pixelValue;
-            }
-        }
+void ObjectDetectorDarknetImpl::initNeuralNetworkIfNecessary() {
+    if (pNeuralNetwork) {
+        return;
     }
 
-    rgbgr_image(dest);
+    batchSize = std::max(1, configuration.objectDetectionBatchSize);
+    LOG_INFO(logger) << "Loading the YOLO neural network model (batch size = " << batchSize
+        << ", input conversion = " << utils::BgrToPlanarConverter::getInstructionSetName() << ")...";
+    pNeuralNetwork = std::unique_ptr<network>(load_network_custom(
+        (char*) configuration.yoloModelCfgPath.string().c_str(), 
+        (char*) configuration.yoloModelWeightsPath.string().c_str(), 
+        /*clear = */ 0,
+        /*batch = */ batchSize));
+    
+    objectTypesByClassId = DetectedObjectTypeHelper::stringsToEnums(configuration.yoloModelClassNames);
+    networkInput.assign(batchSize * pNeuralNetwork->w * pNeuralNetwork->h * 3, 0.0f);
+    pInputPreprocessor = std::make_unique<utils::NetworkInputPreprocessor>(
+        cv::Size(pNeuralNetwork->w, pNeuralNetwork->h), 1 / 255.0f);
+    pOutputDecoder = std::make_unique<utils::YoloOutputDecoder>(configuration, objectTypesByClassId);
+}
+
+vector<DetectedObject> ObjectDetectorDarknetImpl::extractDetectedObjects(
+    detection* detections, int nbDetections, cv::Size frameSize) {
+
+    vector<DetectedObject> detectedObjects;
+    for (int detectionIndex = 0; detectionIndex < nbDetections; detectionIndex++) {
+        const detection& detection = detections[detectionIndex];
+        pOutputDecoder->decode(
+            detection.bbox.x, detection.bbox.y, detection.bbox.w, detection.bbox.h,
+            detection.objectness, detection.prob, detection.classes,
+            frameSize, detectedObjects);
+    }
+
+    return detectedObjects;
+}
+
+vector<DetectedObject> ObjectDetectorDarknetImpl::suppressDuplicates(
+    int frameIndex, const vector<DetectedObject>& detectedObjects) {
 
-    return dest;
+    vector<DetectedObject> keptObjects = nonMaximumSuppressor.suppress(detectedObjects);
+    LOG_INFO(logger) << "Non-maximum suppression of the frame " << frameIndex << ": "
+        << detectedObjects.size() << " objects in, " << keptObjects.size() << " objects out.";
+    return keptObjects;
 }
\ No newline at end of file
@@ -2,19 +2,25 @@
 #define SERVICE_OBJECT_DETECTOR_DARKNET_IMPL
 
 #include <memory>
+#include <vector>
+#include <opencv2/opencv.hpp>
 #include <boost/filesystem.hpp>
 #include <darknet.h>
 #include "../../model/Configuration.hpp"
-#include "../../model/VideoProperties.hpp"
 #include "../../utils/logging.hpp"
+#include "../../utils/NetworkInputPreprocessor.hpp"
+#include "../../utils/NonMaximumSuppressor.hpp"
+#include "../../utils/YoloOutputDecoder.hpp"
 #include "../ObjectDetector.hpp"
-#include "../VideoFrameReader.hpp"
 
 namespace service {
 
     /**
      * Implementation of the {@link ObjectDetector} by using the YOLO v3 model running
      * on top of Darknet (very fast with CUDA, slow without it).
+     *
+     * The network is loaded with a batch size of objectDetection.batchSize, so several frames are
+     * processed by one prediction. The network input buffer is allocated once and reused.
      * 
      * @author Marc Plouhinec
      */
@@ -23,32 +29,40 @@ namespace service {
             boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
 
             const model::Configuration& configuration;
-            VideoFrameReader& videoFrameReader;
-            const model::VideoProperties& videoProperties;
             std::unique_ptr<network> pNeuralNetwork{};
-            layer lastLayer;
+            int batchSize = 1;
+            std::vector<float> networkInput;
+            std::unique_ptr<utils::NetworkInputPreprocessor> pInputPreprocessor{};
             std::vector<model::DetectedObjectType> objectTypesByClassId;
-
-            float minTipConfidence = 0;
-            float minChopstickConfidence = 0;
-            float minArmConfidence = 0;
-            float minConfidence = 0;
+            std::unique_ptr<utils::YoloOutputDecoder> pOutputDecoder{};
+            utils::NonMaximumSuppressor nonMaximumSuppressor;
 
         public:
             ObjectDetectorDarknetImpl(
-                const model::Configuration& configuration,
-                VideoFrameReader& videoFrameReader,
-                const model::VideoProperties& videoProperties) : 
+                const model::Configuration& configuration) :
                     configuration(configuration),
-                    videoFrameReader(videoFrameReader),
-                    videoProperties(videoProperties) {}
+                    nonMaximumSuppressor(configuration.objectDetectionNmsThreshold) {}
 
             virtual ~ObjectDetectorDarknetImpl() {};
 
-            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex);
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame);
+
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+            virtual void warmUp();
         
         private:
-            image matToImage(cv::Mat& src);
+            void initNeuralNetworkIfNecessary();
+
+            /**
+             * Remove the duplicated objects detected in the given frame.
+             */
+            std::vector<model::DetectedObject> suppressDuplicates(
+                int frameIndex, const std::vector<model::DetectedObject>& detectedObjects);
+
+            std::vector<model::DetectedObject> extractDetectedObjects(
+                detection* detections, int nbDetections, cv::Size frameSize);
     };
 
 }
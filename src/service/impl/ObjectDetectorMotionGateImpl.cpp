@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <math.h>
+#include "ObjectDetectorMotionGateImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::round;
+using std::vector;
+
+ObjectDetectorMotionGateImpl::~ObjectDetectorMotionGateImpl() {
+    int nbFrames = nbDetectedFrames + nbSkippedFrames;
+    if (nbFrames > 0) {
+        LOG_INFO(logger) << "Motion gate: " << nbDetectedFrames << " frames detected, " << nbSkippedFrames
+            << " frames skipped (" << (100.0 * nbSkippedFrames / nbFrames) << "%), "
+            << nbSkipLimitDetections << " detections because of the maximum number of consecutive skips.";
+    }
+}
+
+vector<DetectedObject> ObjectDetectorMotionGateImpl::detectObjectsAt(int frameIndex, const cv::Mat& frame) {
+    return detectObjectsAt(frameIndex, vector<cv::Mat>{ frame })[0];
+}
+
+void ObjectDetectorMotionGateImpl::warmUp() {
+    wrappedObjectDetector.warmUp();
+}
+
+vector<vector<DetectedObject>> ObjectDetectorMotionGateImpl::detectObjectsAt(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    double maxDifference = configuration.objectDetectionMotionGateMaxDifference;
+    int maxConsecutiveSkips = configuration.objectDetectionMotionGateMaxConsecutiveSkips;
+    double scale = configuration.objectDetectionMotionGateScale;
+    vector<vector<DetectedObject>> detectedObjectsByFrame;
+
+    for (size_t frameOffset = 0; frameOffset < frames.size(); frameOffset++) {
+        int frameIndex = firstFrameIndex + frameOffset;
+        const cv::Mat& frame = frames[frameOffset];
+        cv::Mat grayFrame = toDownscaledGrayFrame(frame);
+
+        // Reuse the last detected objects if the frame is almost the same as the reference one
+        bool isSkipped = false;
+        vector<DetectedObject> detectedObjects;
+        if (!referenceGrayFrame.empty() && referenceGrayFrame.size() == grayFrame.size()) {
+            if (nbConsecutiveSkips >= maxConsecutiveSkips) {
+                nbSkipLimitDetections++;
+            } else {
+                if (hanningWindow.size() != grayFrame.size()) {
+                    cv::createHanningWindow(hanningWindow, grayFrame.size(), CV_32F);
+                }
+                cv::Point2d offset = cv::phaseCorrelate(referenceGrayFrame, grayFrame, hanningWindow);
+                double difference = computeDifference(grayFrame, offset);
+                if (difference >= 0 && difference <= maxDifference) {
+                    isSkipped = true;
+                    for (const DetectedObject& referenceDetectedObject : referenceDetectedObjects) {
+                        DetectedObject detectedObject =
+                            referenceDetectedObject.copyAndTranslate(offset.x / scale, offset.y / scale);
+                        detectedObject.isPropagated = true;
+                        detectedObjects.push_back(detectedObject);
+                    }
+                }
+            }
+        }
+
+        if (isSkipped) {
+            nbConsecutiveSkips++;
+            nbSkippedFrames++;
+        } else {
+            detectedObjects = wrappedObjectDetector.detectObjectsAt(frameIndex, frame);
+            referenceGrayFrame = grayFrame;
+            referenceDetectedObjects = detectedObjects;
+            nbConsecutiveSkips = 0;
+            nbDetectedFrames++;
+        }
+
+        detectedObjectsByFrame.push_back(std::move(detectedObjects));
+    }
+
+    return detectedObjectsByFrame;
+}
+
+cv::Mat ObjectDetectorMotionGateImpl::toDownscaledGrayFrame(const cv::Mat& frame) const {
+    double scale = configuration.objectDetectionMotionGateScale;
+    cv::Mat grayFrame;
+    cv::cvtColor(frame, grayFrame, cv::COLOR_BGR2GRAY);
+    cv::Mat downscaledGrayFrame;
+    cv::resize(grayFrame, downscaledGrayFrame, cv::Size(), scale, scale, cv::INTER_AREA);
+
+    // Note: phaseCorrelate() needs floating-point images
+    cv::Mat floatGrayFrame;
+    downscaledGrayFrame.convertTo(floatGrayFrame, CV_32F);
+    return floatGrayFrame;
+}
+
+double ObjectDetectorMotionGateImpl::computeDifference(const cv::Mat& grayFrame, cv::Point2d offset) const {
+    int dx = (int) round(offset.x);
+    int dy = (int) round(offset.y);
+    int width = grayFrame.cols;
+    int height = grayFrame.rows;
+
+    // The pixel (x, y) of the reference frame is at (x + dx, y + dy) in the given frame
+    cv::Rect referenceROI(std::max(0, -dx), std::max(0, -dy), 0, 0);
+    referenceROI.width = std::min(width, width - dx) - referenceROI.x;
+    referenceROI.height = std::min(height, height - dy) - referenceROI.y;
+    if (referenceROI.width <= 0 || referenceROI.height <= 0) {
+        return -1;
+    }
+    cv::Rect frameROI(referenceROI.x + dx, referenceROI.y + dy, referenceROI.width, referenceROI.height);
+
+    cv::Mat difference;
+    cv::absdiff(referenceGrayFrame(referenceROI), grayFrame(frameROI), difference);
+    return cv::mean(difference)[0];
+}
@@ -0,0 +1,69 @@
+#ifndef SERVICE_OBJECT_DETECTOR_MOTION_GATE_IMPL
+#define SERVICE_OBJECT_DETECTOR_MOTION_GATE_IMPL
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link ObjectDetector} that wraps another {@link ObjectDetector} and skips it
+     * when nothing moves.
+     *
+     * Each frame is compared with the last frame given to the wrapped detector (both downscaled and in
+     * grayscale): the global offset between them is estimated by phase correlation, then the mean absolute
+     * difference of their overlapping parts is computed. When it is lower than
+     * objectDetection.motionGateMaxDifference, the last detected objects are returned, translated by the
+     * offset and marked as propagated. At most objectDetection.motionGateMaxConsecutiveSkips frames are
+     * skipped in a row, in order to limit the drift.
+     *
+     * @author Marc Plouhinec
+     */
+    class ObjectDetectorMotionGateImpl : public ObjectDetector {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            ObjectDetector& wrappedObjectDetector;
+
+            int nbConsecutiveSkips = 0;
+            cv::Mat referenceGrayFrame;
+            cv::Mat hanningWindow;
+            std::vector<model::DetectedObject> referenceDetectedObjects;
+
+            int nbDetectedFrames = 0;
+            int nbSkippedFrames = 0;
+            int nbSkipLimitDetections = 0;
+
+        public:
+            ObjectDetectorMotionGateImpl(
+                const model::Configuration& configuration,
+                ObjectDetector& wrappedObjectDetector) :
+                    configuration(configuration),
+                    wrappedObjectDetector(wrappedObjectDetector) {}
+
+            virtual ~ObjectDetectorMotionGateImpl();
+
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame);
+
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+            virtual void warmUp();
+
+        private:
+            cv::Mat toDownscaledGrayFrame(const cv::Mat& frame) const;
+
+            /**
+             * @return Mean absolute difference between the reference frame and the given one once it is
+             *         moved by the given offset, or a negative value if they don't overlap.
+             */
+            double computeDifference(const cv::Mat& grayFrame, cv::Point2d offset) const;
+    };
+
+}
+
+#endif // SERVICE_OBJECT_DETECTOR_MOTION_GATE_IMPL
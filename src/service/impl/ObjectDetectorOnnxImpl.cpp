@@ -0,0 +1,235 @@
+#include <chrono>
+#include <stdexcept>
+#include "ObjectDetectorOnnxImpl.hpp"
+#include "../../utils/DnnBackendHelper.hpp"
+#include "../../utils/MemoryMappedFile.hpp"
+#include "../../utils/OnnxModelReader.hpp"
+#include "../../utils/ProcessMemory.hpp"
+
+using namespace model;
+using namespace service;
+using std::min;
+using std::string;
+using std::vector;
+
+vector<DetectedObject> ObjectDetectorOnnxImpl::detectObjectsAt(int frameIndex, const cv::Mat& frame) {
+    return detectObjectsAt(frameIndex, vector<cv::Mat>{ frame })[0];
+}
+
+vector<vector<DetectedObject>> ObjectDetectorOnnxImpl::detectObjectsAt(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    int nbFrames = frames.size();
+    initNeuralNetworkIfNecessary();
+
+    // Detect objects in all the frames with one forward pass
+    neuralNetwork.setInput(pInputPreprocessor->preprocess(frames));
+    cv::Mat output = neuralNetwork.forward(outLayerName);
+
+    // The output contains one matrix of detections per frame (3 dimensions), or one matrix when the
+    // exporter removed the batch dimension
+    if (output.dims != 3 && !(output.dims == 2 && nbFrames == 1)) {
+        throw std::runtime_error("Unsupported shape of the ONNX model output: " + std::to_string(output.dims)
+            + " dimensions for a batch of " + std::to_string(nbFrames) + " frames.");
+    }
+    int nbOutputRows = output.dims == 3 ? output.size[1] : output.size[0];
+    int nbOutputCols = output.dims == 3 ? output.size[2] : output.size[1];
+    resolveOutputLayoutIfNecessary(nbOutputRows, nbOutputCols);
+
+    vector<vector<DetectedObject>> detectedObjectsByFrame(nbFrames);
+    for (int frameOffset = 0; frameOffset < nbFrames; frameOffset++) {
+        cv::Mat frameOutput(nbOutputRows, nbOutputCols, CV_32F, (void*) output.ptr<float>(frameOffset));
+        decodeFrameOutput(frameOutput, frames[frameOffset].size(), detectedObjectsByFrame[frameOffset]);
+
+        detectedObjectsByFrame[frameOffset] = suppressDuplicates(
+            firstFrameIndex + frameOffset, detectedObjectsByFrame[frameOffset]);
+    }
+    return detectedObjectsByFrame;
+}
+
+void ObjectDetectorOnnxImpl::warmUp() {
+    initNeuralNetworkIfNecessary();
+
+    // Note: the first forward pass with a given batch size allocates the buffers of all the layers
+    cv::Mat blankFrame(pInputPreprocessor->getInputSize(), CV_8UC3, cv::Scalar(0, 0, 0));
+    vector<cv::Mat> blankFrames(std::max(1, configuration.objectDetectionBatchSize), blankFrame);
+    neuralNetwork.setInput(pInputPreprocessor->preprocess(blankFrames));
+    neuralNetwork.forward(outLayerName);
+}
+
+void ObjectDetectorOnnxImpl::initNeuralNetworkIfNecessary() {
+    if (!neuralNetworkInitialized) {
+        if (isQuantized && (CV_VERSION_MAJOR < 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR < 7))) {
+            throw std::runtime_error("INT8 ONNX models require OpenCV 4.7 or later (current version: "
+                CV_VERSION ").");
+        }
+
+        LOG_INFO(logger) << "Loading the " << (isQuantized ? "INT8" : "FP32")
+            << " ONNX neural network model " << modelPath << "...";
+        auto loadingStartTime = std::chrono::steady_clock::now();
+        size_t residentSetSizeBeforeLoading = utils::ProcessMemory::getResidentSetSize();
+
+        // The model is memory-mapped: OpenCV parses the buffer in place, so its pages come from the page cache
+        // shared by all the processes. The input shape is read from the graph before OpenCV copies the weights
+        vector<int64_t> inputShape;
+        {
+            utils::MemoryMappedFile yoloModelOnnxFile(modelPath);
+            if (!yoloModelOnnxFile.isReadAheadAdvised()) {
+                LOG_WARN(logger) << "Unable to enable the read-ahead of " << modelPath.string()
+                    << ", the model may load slowly.";
+            }
+            inputShape = utils::OnnxModelReader::readInputShape(yoloModelOnnxFile.data(), yoloModelOnnxFile.size());
+            neuralNetwork = cv::dnn::readNetFromONNX(yoloModelOnnxFile.data(), yoloModelOnnxFile.size());
+        }
+        if (inputShape.size() != 4 || (inputShape[1] != 3 && inputShape[1] != -1)) {
+            throw std::runtime_error("The input of the ONNX model must be a batch of RGB images (NCHW).");
+        }
+        int netHeight = inputShape[2] > 0 ? inputShape[2] : configuration.yoloModelOnnxInputSize;
+        int netWidth = inputShape[3] > 0 ? inputShape[3] : configuration.yoloModelOnnxInputSize;
+        if (inputShape[0] > 0 && inputShape[0] != std::max(1, configuration.objectDetectionBatchSize)) {
+            LOG_WARN(logger) << "The ONNX model was exported with a fixed batch size of " << inputShape[0]
+                << " images, but objectDetection.batchSize = " << configuration.objectDetectionBatchSize
+                << ": the model may fail, please export it with a dynamic batch size.";
+        }
+        pInputPreprocessor = std::make_unique<utils::NetworkInputPreprocessor>(
+            cv::Size(netWidth, netHeight), 1 / 255.0f);
+
+        // The quantized layers of OpenCV only run with its own backend on the CPU
+        string backendName = configuration.objectDetectionDnnBackend;
+        string targetName = configuration.objectDetectionDnnTarget;
+        if (isQuantized && ((backendName != "default" && backendName != "opencv") || targetName != "cpu")) {
+            LOG_WARN(logger) << "The backend " << backendName << " / " << targetName
+                << " does not support INT8 models: opencv / cpu is used instead.";
+            backendName = "opencv";
+            targetName = "cpu";
+        }
+        neuralNetwork.setPreferableBackend(utils::DnnBackendHelper::stringToBackend(backendName));
+        neuralNetwork.setPreferableTarget(utils::DnnBackendHelper::stringToTarget(targetName));
+
+        // Exporters sometimes keep intermediate outputs: only the first one contains the detections
+        vector<string> outLayerNames = neuralNetwork.getUnconnectedOutLayersNames();
+        if (outLayerNames.empty()) {
+            throw std::runtime_error("The ONNX model has no output.");
+        }
+        outLayerName = outLayerNames[0];
+        for (size_t i = 1; i < outLayerNames.size(); i++) {
+            LOG_WARN(logger) << "The output " << outLayerNames[i] << " of the ONNX model is ignored.";
+        }
+
+        objectTypesByClassId = DetectedObjectTypeHelper::stringsToEnums(configuration.yoloModelClassNames);
+        pOutputDecoder = std::make_unique<utils::YoloOutputDecoder>(configuration, objectTypesByClassId);
+
+        double loadingDurationMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - loadingStartTime).count();
+        size_t residentSetSizeAfterLoading = utils::ProcessMemory::getResidentSetSize();
+        LOG_INFO(logger) << "ONNX model loaded in " << loadingDurationMs << " ms (resident memory: "
+            << (residentSetSizeBeforeLoading >> 20) << " MB before, "
+            << (residentSetSizeAfterLoading >> 20) << " MB after).";
+
+        LOG_INFO(logger) << "ONNX model initialized: outLayerName = " << outLayerName
+            << ", netWidth = " << netWidth << ", netHeight = " << netHeight
+            << ", backend = " << backendName
+            << ", target = " << targetName;
+
+        neuralNetworkInitialized = true;
+    }
+}
+
+void ObjectDetectorOnnxImpl::resolveOutputLayoutIfNecessary(int nbBoxesOrChannels, int nbChannelsOrBoxes) {
+    if (outputLayoutResolved) {
+        return;
+    }
+
+    const string& outputLayout = configuration.yoloModelOnnxOutputLayout;
+    int nbClasses = objectTypesByClassId.size();
+    if (outputLayout == "yolov5") {
+        isOutputTransposed = false;
+        hasObjectness = true;
+        isConfidenceMultipliedByObjectness = true;
+    } else if (outputLayout == "yolov8") {
+        isOutputTransposed = true;
+        hasObjectness = false;
+    } else if (outputLayout == "darknet") {
+        isOutputTransposed = false;
+        hasObjectness = true;
+        areCoordinatesRelative = true;
+    } else if (outputLayout == "auto") {
+        // There are always much more boxes than channels (box, objectness and class confidences)
+        isOutputTransposed = nbBoxesOrChannels < nbChannelsOrBoxes;
+        int nbChannels = min(nbBoxesOrChannels, nbChannelsOrBoxes);
+        if (nbChannels == 5 + nbClasses) {
+            hasObjectness = true;
+            isConfidenceMultipliedByObjectness = true;
+        } else if (nbChannels == 4 + nbClasses) {
+            hasObjectness = false;
+        } else {
+            throw std::runtime_error("Unable to guess the layout of the ONNX model output ("
+                + std::to_string(nbBoxesOrChannels) + "x" + std::to_string(nbChannelsOrBoxes) + " values for "
+                + std::to_string(nbClasses) + " classes), please set yoloModel.onnxoutputlayout.");
+        }
+    } else {
+        throw std::runtime_error("Unknown yoloModel.onnxoutputlayout: " + outputLayout);
+    }
+
+    int nbChannels = isOutputTransposed ? nbBoxesOrChannels : nbChannelsOrBoxes;
+    if (nbChannels < (hasObjectness ? 5 : 4) + 1) {
+        throw std::runtime_error("The ONNX model output has too few values per box: " + std::to_string(nbChannels));
+    }
+    classConfidences.resize(nbChannels);
+
+    LOG_INFO(logger) << "ONNX model output layout: " << outputLayout
+        << ", nbBoxes = " << (isOutputTransposed ? nbChannelsOrBoxes : nbBoxesOrChannels)
+        << ", nbChannels = " << nbChannels
+        << ", isOutputTransposed = " << isOutputTransposed
+        << ", hasObjectness = " << hasObjectness
+        << ", areCoordinatesRelative = " << areCoordinatesRelative;
+    outputLayoutResolved = true;
+}
+
+void ObjectDetectorOnnxImpl::decodeFrameOutput(
+    const cv::Mat& frameOutput, cv::Size frameSize, vector<DetectedObject>& detectedObjects) {
+
+    // Read the boxes as contiguous rows
+    const cv::Mat* pRows = &frameOutput;
+    if (isOutputTransposed) {
+        cv::transpose(frameOutput, transposedFrameOutput);
+        pRows = &transposedFrameOutput;
+    }
+    int nbRows = pRows->rows;
+    int firstClassCol = hasObjectness ? 5 : 4;
+    int nbClasses = pRows->cols - firstClassCol;
+
+    // The coordinates are converted to be relative to the input size, which is also relative to the frame
+    cv::Size inputSize = pInputPreprocessor->getInputSize();
+    float scaleX = areCoordinatesRelative ? 1.0f : 1.0f / inputSize.width;
+    float scaleY = areCoordinatesRelative ? 1.0f : 1.0f / inputSize.height;
+    float minConfidence = pOutputDecoder->getMinConfidence();
+
+    for (int rowIndex = 0; rowIndex < nbRows; rowIndex++) {
+        const float* pRow = pRows->ptr<float>(rowIndex);
+        float objectness = hasObjectness ? pRow[4] : 1.0f;
+        const float* pClassConfidences = pRow + firstClassCol;
+        if (isConfidenceMultipliedByObjectness) {
+            if (objectness < minConfidence) {
+                continue;
+            }
+            for (int classId = 0; classId < nbClasses; classId++) {
+                classConfidences[classId] = pClassConfidences[classId] * objectness;
+            }
+            pClassConfidences = classConfidences.data();
+        }
+
+        pOutputDecoder->decode(
+            pRow[0] * scaleX, pRow[1] * scaleY, pRow[2] * scaleX, pRow[3] * scaleY,
+            objectness, pClassConfidences, nbClasses, frameSize, detectedObjects);
+    }
+}
+
+vector<DetectedObject> ObjectDetectorOnnxImpl::suppressDuplicates(
+    int frameIndex, const vector<DetectedObject>& detectedObjects) {
+
+    vector<DetectedObject> keptObjects = nonMaximumSuppressor.suppress(detectedObjects);
+    LOG_INFO(logger) << "Non-maximum suppression of the frame " << frameIndex << ": "
+        << detectedObjects.size() << " objects in, " << keptObjects.size() << " objects out.";
+    return keptObjects;
+}
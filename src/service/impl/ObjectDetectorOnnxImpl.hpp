@@ -0,0 +1,103 @@
+#ifndef SERVICE_OBJECT_DETECTOR_ONNX_IMPL
+#define SERVICE_OBJECT_DETECTOR_ONNX_IMPL
+
+#include <memory>
+#include <opencv2/dnn.hpp>
+#include <opencv2/opencv.hpp>
+#include <boost/filesystem.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../../utils/NetworkInputPreprocessor.hpp"
+#include "../../utils/NonMaximumSuppressor.hpp"
+#include "../../utils/YoloOutputDecoder.hpp"
+#include "../ObjectDetector.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link ObjectDetector} by running a YOLO model exported in the ONNX format
+     * (e.g. the small models produced by the training pipeline) on top of OpenCV DNN.
+     *
+     * The size of the input images is read from the model, and the output tensor can have the layout of
+     * YOLOv5 (one row per box, with an objectness), YOLOv8 (one column per box, without objectness) or
+     * Darknet (like YOLOv5, with coordinates relative to the image size).
+     *
+     * The same implementation runs the INT8 models produced by the quantization script (QuantizeLinear and
+     * DequantizeLinear nodes), which OpenCV 4.7+ converts into quantized layers running on the CPU.
+     *
+     * @author Marc Plouhinec
+     */
+    class ObjectDetectorOnnxImpl : public ObjectDetector {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const boost::filesystem::path modelPath;
+            const bool isQuantized;
+
+            bool neuralNetworkInitialized = false;
+            cv::dnn::Net neuralNetwork;
+            std::unique_ptr<utils::NetworkInputPreprocessor> pInputPreprocessor{};
+            std::string outLayerName;
+            std::vector<model::DetectedObjectType> objectTypesByClassId;
+            std::unique_ptr<utils::YoloOutputDecoder> pOutputDecoder{};
+            utils::NonMaximumSuppressor nonMaximumSuppressor;
+
+            bool outputLayoutResolved = false;
+            bool isOutputTransposed = false;
+            bool hasObjectness = true;
+            bool isConfidenceMultipliedByObjectness = false;
+            bool areCoordinatesRelative = false;
+            cv::Mat transposedFrameOutput;
+            std::vector<float> classConfidences;
+
+        public:
+            /**
+             * @param modelPath Path to the .onnx file (yoloModel.onnxpath or yoloModel.onnxint8path).
+             * @param isQuantized True if the model is quantized in INT8.
+             */
+            ObjectDetectorOnnxImpl(
+                const model::Configuration& configuration,
+                const boost::filesystem::path& modelPath,
+                bool isQuantized) :
+                    configuration(configuration),
+                    modelPath(modelPath),
+                    isQuantized(isQuantized),
+                    nonMaximumSuppressor(configuration.objectDetectionNmsThreshold) {}
+
+            virtual ~ObjectDetectorOnnxImpl() {}
+
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame);
+
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+            virtual void warmUp();
+
+        private:
+            void initNeuralNetworkIfNecessary();
+
+            /**
+             * Find the layout of the output tensor from its shape (or from yoloModel.onnxoutputlayout).
+             *
+             * @param nbBoxesOrChannels First dimension of the output of one frame.
+             * @param nbChannelsOrBoxes Second dimension of the output of one frame.
+             */
+            void resolveOutputLayoutIfNecessary(int nbBoxesOrChannels, int nbChannelsOrBoxes);
+
+            /**
+             * Decode the output of one frame (2D matrix).
+             */
+            void decodeFrameOutput(
+                const cv::Mat& frameOutput, cv::Size frameSize, std::vector<model::DetectedObject>& detectedObjects);
+
+            /**
+             * Remove the duplicated objects detected in the given frame.
+             */
+            std::vector<model::DetectedObject> suppressDuplicates(
+                int frameIndex, const std::vector<model::DetectedObject>& detectedObjects);
+    };
+
+}
+
+#endif // SERVICE_OBJECT_DETECTOR_ONNX_IMPL
@@ -1,9 +1,12 @@
+#include <chrono>
 #include <math.h>
 #include <fstream>
 #include <streambuf>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 #include "ObjectDetectorOpenCvDnnImpl.hpp"
+#include "../../utils/DnnBackendHelper.hpp"
+#include "../../utils/ProcessMemory.hpp"
 
 using namespace model;
 using namespace service;
@@ -15,15 +18,81 @@ using std::string;
 using std::vector;
 namespace pt = boost::property_tree;
 
-vector<DetectedObject> ObjectDetectorOpenCvDnnImpl::detectObjectsAt(int frameIndex) {
-    cv::Mat frame = videoFrameReader.readFrameAt(frameIndex);
+vector<DetectedObject> ObjectDetectorOpenCvDnnImpl::detectObjectsAt(int frameIndex, const cv::Mat& frame) {
+    return detectObjectsAt(frameIndex, vector<cv::Mat>{ frame })[0];
+}
 
+vector<vector<DetectedObject>> ObjectDetectorOpenCvDnnImpl::detectObjectsAt(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    int nbFrames = frames.size();
+    initNeuralNetworkIfNecessary();
+
+    // Detect objects in all the frames with one forward pass
+    neuralNetwork.setInput(pInputPreprocessor->preprocess(frames));
+    vector<cv::Mat> layerOutputs;
+    neuralNetwork.forward(layerOutputs, outLayerNames);
+
+    // Extract objects
+    vector<vector<DetectedObject>> detectedObjectsByFrame(nbFrames);
+    for (const cv::Mat& layerOutput : layerOutputs) {
+        for (int frameOffset = 0; frameOffset < nbFrames; frameOffset++) {
+            // With a batch of several images, the YOLO layers return one matrix of detections per image
+            // (3 dimensions), or all the detections of the batch in one 2D matrix with older OpenCV versions
+            cv::Mat frameLayerOutput = layerOutput;
+            if (layerOutput.dims == 3) {
+                frameLayerOutput = cv::Mat(
+                    layerOutput.size[1], layerOutput.size[2], CV_32F,
+                    (void*) layerOutput.ptr<float>(frameOffset));
+            } else if (nbFrames > 1) {
+                int nbRowsPerFrame = layerOutput.rows / nbFrames;
+                frameLayerOutput = layerOutput.rowRange(
+                    frameOffset * nbRowsPerFrame, (frameOffset + 1) * nbRowsPerFrame);
+            }
+
+            pOutputDecoder->decodeRows(
+                frameLayerOutput.ptr<float>(), frameLayerOutput.rows, frameLayerOutput.cols,
+                frames[frameOffset].size(), detectedObjectsByFrame[frameOffset]);
+        }
+    }
+
+    // Remove the duplicated objects found by the different output layers and anchors
+    for (int frameOffset = 0; frameOffset < nbFrames; frameOffset++) {
+        detectedObjectsByFrame[frameOffset] = suppressDuplicates(
+            firstFrameIndex + frameOffset, detectedObjectsByFrame[frameOffset]);
+    }
+    return detectedObjectsByFrame;
+}
+
+void ObjectDetectorOpenCvDnnImpl::warmUp() {
+    initNeuralNetworkIfNecessary();
+
+    // Note: the first forward pass with a given batch size allocates the buffers of all the layers
+    cv::Mat blankFrame(pInputPreprocessor->getInputSize(), CV_8UC3, cv::Scalar(0, 0, 0));
+    vector<cv::Mat> blankFrames(std::max(1, configuration.objectDetectionBatchSize), blankFrame);
+    neuralNetwork.setInput(pInputPreprocessor->preprocess(blankFrames));
+    vector<cv::Mat> layerOutputs;
+    neuralNetwork.forward(layerOutputs, outLayerNames);
+}
+
+void ObjectDetectorOpenCvDnnImpl::initNeuralNetworkIfNecessary() {
     if (!neuralNetworkInitialized) {
         LOG_INFO(logger) << "Loading the YOLO neural network model...";
+        auto loadingStartTime = std::chrono::steady_clock::now();
+        size_t residentSetSizeBeforeLoading = utils::ProcessMemory::getResidentSetSize();
+
+        // Note: OpenCV DNN cannot share the Darknet weights between processes: each network copies them into
+        // its own layers. The file paths are given instead of memory-mapped buffers because the buffer
+        // overload first copies the whole weights file into a private string stream, which increases the peak
+        // resident memory.
         string yoloModelCfgPath = configuration.yoloModelCfgPath.string();
         string yoloModelWeights = configuration.yoloModelWeightsPath.string();
         neuralNetwork = cv::dnn::readNetFromDarknet(yoloModelCfgPath, yoloModelWeights);
-        
+        neuralNetwork.setPreferableBackend(
+            utils::DnnBackendHelper::stringToBackend(configuration.objectDetectionDnnBackend));
+        neuralNetwork.setPreferableTarget(
+            utils::DnnBackendHelper::stringToTarget(configuration.objectDetectionDnnTarget));
+
         outLayerNames = neuralNetwork.getUnconnectedOutLayersNames();
         objectTypesByClassId = DetectedObjectTypeHelper::stringsToEnums(configuration.yoloModelClassNames);
 
@@ -39,81 +108,32 @@ vector<DetectedObject> ObjectDetectorOpenCvDnnImpl::detectObjectsAt(int frameInd
         pt::ini_parser::read_ini(cfgNetSectionStream, propTree);
         int netWidth = propTree.get<int>("net.width");
         int netHeight = propTree.get<int>("net.height");
-        blobSize = cv::Size(netWidth, netHeight);
-        mean = cv::Scalar(0, 0, 0, 0);
+        pInputPreprocessor = std::make_unique<utils::NetworkInputPreprocessor>(
+            cv::Size(netWidth, netHeight), 1 / 255.0f);
         
+        double loadingDurationMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - loadingStartTime).count();
+        size_t residentSetSizeAfterLoading = utils::ProcessMemory::getResidentSetSize();
+        LOG_INFO(logger) << "YOLO model loaded in " << loadingDurationMs << " ms (resident memory: "
+            << (residentSetSizeBeforeLoading >> 20) << " MB before, "
+            << (residentSetSizeAfterLoading >> 20) << " MB after).";
+
         LOG_INFO(logger) << "YOLO model initialized: outLayerNames = " << "outLayerNames"
-            << ", netWidth = " << netWidth << ", netHeight = " << netHeight;
-        
-        minTipConfidence = configuration.objectDetectionMinTipConfidence;
-        minChopstickConfidence = configuration.objectDetectionMinChopstickConfidence;
-        minArmConfidence = configuration.objectDetectionMinArmConfidence;
-        minConfidence = min(minTipConfidence, min(minChopstickConfidence, minArmConfidence));
+            << ", netWidth = " << netWidth << ", netHeight = " << netHeight
+            << ", backend = " << configuration.objectDetectionDnnBackend
+            << ", target = " << configuration.objectDetectionDnnTarget;
+
+        pOutputDecoder = std::make_unique<utils::YoloOutputDecoder>(configuration, objectTypesByClassId);
 
         neuralNetworkInitialized = true;
     }
+}
 
-    // Detect objects
-    cv::Mat blob = cv::dnn::blobFromImage(
-        frame, 1 / 255.0, blobSize, mean, /* swapRB = */true, /* crop = */false, /* ddepth = */ CV_32F);
-    neuralNetwork.setInput(blob);
-    vector<cv::Mat> layerOutputs;
-    neuralNetwork.forward(layerOutputs, outLayerNames);
-
-    // Extract objects
-    vector<DetectedObject> detectedObjects;
-    for (cv::Mat layerOutput : layerOutputs) {
-        for (int rowIndex = 0; rowIndex < layerOutput.rows; rowIndex++) {
-            int probStartIndex = 5;
-            int probSize = layerOutput.cols - probStartIndex;
-
-            // Find the detected class and confidence
-            int classId = -1;
-            float confidence = -1.0f;
-            for (int probIndex = probStartIndex; probIndex < probStartIndex + probSize; probIndex++) {
-                float probability = layerOutput.at<float>(rowIndex, probIndex);
-                if (probability > confidence) {
-                    confidence = probability;
-                    classId = probIndex - probStartIndex;
-                }
-            }
+vector<DetectedObject> ObjectDetectorOpenCvDnnImpl::suppressDuplicates(
+    int frameIndex, const vector<DetectedObject>& detectedObjects) {
 
-            // If the confidence is high enough, 
-            if (confidence >= minConfidence) {
-                DetectedObjectType objectType = objectTypesByClassId[classId];
-            
-                float minConfidenceForType = minConfidence;
-                switch (objectType) {
-                    case DetectedObjectType::SMALL_TIP:
-                    case DetectedObjectType::BIG_TIP:
-                        minConfidenceForType = minTipConfidence;
-                        break;
-                    case DetectedObjectType::ARM:
-                        minConfidenceForType = minArmConfidence;
-                        break;
-                    case DetectedObjectType::CHOPSTICK:
-                    default:
-                        minConfidenceForType = minChopstickConfidence;
-                        break;
-                }
-
-                if (confidence >= minConfidenceForType) {
-                    float centerX = layerOutput.at<float>(rowIndex, 0) * videoProperties.frameWidth;
-                    float centerY = layerOutput.at<float>(rowIndex, 1) * videoProperties.frameHeight;
-                    float width = layerOutput.at<float>(rowIndex, 2) * videoProperties.frameWidth;
-                    float height = layerOutput.at<float>(rowIndex, 3) * videoProperties.frameHeight;
-                    float x = centerX - (width / 2);
-                    float y = centerY - (height / 2);
-
-                    const DetectedObject detectedObject(
-                        x, y,
-                        width, height,
-                        objectTypesByClassId[classId], 
-                        confidence);
-                    detectedObjects.push_back(detectedObject);
-                }
-            }
-        }
-    }
-    return detectedObjects;
+    vector<DetectedObject> keptObjects = nonMaximumSuppressor.suppress(detectedObjects);
+    LOG_INFO(logger) << "Non-maximum suppression of the frame " << frameIndex << ": "
+        << detectedObjects.size() << " objects in, " << keptObjects.size() << " objects out.";
+    return keptObjects;
 }
\ No newline at end of file
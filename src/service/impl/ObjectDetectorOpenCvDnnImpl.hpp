@@ -1,14 +1,16 @@
 #ifndef SERVICE_OBJECT_DETECTOR_OPENCV_DNN_IMPL
 #define SERVICE_OBJECT_DETECTOR_OPENCV_DNN_IMPL
 
+#include <memory>
 #include <opencv2/dnn.hpp>
 #include <opencv2/opencv.hpp>
 #include <boost/filesystem.hpp>
 #include "../../model/Configuration.hpp"
-#include "../../model/VideoProperties.hpp"
 #include "../../utils/logging.hpp"
+#include "../../utils/NetworkInputPreprocessor.hpp"
+#include "../../utils/NonMaximumSuppressor.hpp"
+#include "../../utils/YoloOutputDecoder.hpp"
 #include "../ObjectDetector.hpp"
-#include "../VideoFrameReader.hpp"
 
 namespace service {
 
@@ -23,33 +25,38 @@ namespace service {
             boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
 
             const model::Configuration& configuration;
-            VideoFrameReader& videoFrameReader;
-            const model::VideoProperties& videoProperties;
 
             bool neuralNetworkInitialized = false;
             cv::dnn::Net neuralNetwork;
-            cv::Size blobSize;
-            cv::Scalar mean;
+            std::unique_ptr<utils::NetworkInputPreprocessor> pInputPreprocessor{};
             std::vector<std::string> outLayerNames;
             std::vector<model::DetectedObjectType> objectTypesByClassId;
-
-            float minTipConfidence = 0;
-            float minChopstickConfidence = 0;
-            float minArmConfidence = 0;
-            float minConfidence = 0;
+            std::unique_ptr<utils::YoloOutputDecoder> pOutputDecoder{};
+            utils::NonMaximumSuppressor nonMaximumSuppressor;
 
         public:
             ObjectDetectorOpenCvDnnImpl(
-                const model::Configuration& configuration,
-                VideoFrameReader& videoFrameReader,
-                const model::VideoProperties& videoProperties) : 
+                const model::Configuration& configuration) :
                     configuration(configuration),
-                    videoFrameReader(videoFrameReader),
-                    videoProperties(videoProperties) {}
+                    nonMaximumSuppressor(configuration.objectDetectionNmsThreshold) {}
 
             virtual ~ObjectDetectorOpenCvDnnImpl() {}
 
-            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex);
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame);
+
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+            virtual void warmUp();
+
+        private:
+            void initNeuralNetworkIfNecessary();
+
+            /**
+             * Remove the duplicated objects detected in the given frame.
+             */
+            std::vector<model::DetectedObject> suppressDuplicates(
+                int frameIndex, const std::vector<model::DetectedObject>& detectedObjects);
     };
 
 }
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <stdexcept>
+#include <opencv2/opencv.hpp>
+#include "ObjectDetectorPoolImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::future;
+using std::max;
+using std::min;
+using std::runtime_error;
+using std::thread;
+using std::vector;
+
+ObjectDetectorPoolImpl::ObjectDetectorPoolImpl(
+    const Configuration& configuration,
+    const vector<ObjectDetector*>& replicas) :
+        configuration(configuration),
+        replicas(replicas),
+        detectionJobs(2 * replicas.size()) {
+}
+
+ObjectDetectorPoolImpl::~ObjectDetectorPoolImpl() {
+    detectionJobs.close();
+    for (thread& replicaThread : replicaThreads) {
+        replicaThread.join();
+    }
+}
+
+vector<DetectedObject> ObjectDetectorPoolImpl::detectObjectsAt(int frameIndex, const cv::Mat& frame) {
+    return submit(frameIndex, vector<cv::Mat>{ frame }).get()[0];
+}
+
+vector<vector<DetectedObject>> ObjectDetectorPoolImpl::detectObjectsAt(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    // Give a sub-batch to each replica
+    int nbFrames = frames.size();
+    int nbFramesPerReplica = (nbFrames + replicas.size() - 1) / replicas.size();
+    vector<future<vector<vector<DetectedObject>>>> futures;
+    for (int frameOffset = 0; frameOffset < nbFrames; frameOffset += nbFramesPerReplica) {
+        int endFrameOffset = min(nbFrames, frameOffset + nbFramesPerReplica);
+        vector<cv::Mat> subBatchFrames(frames.begin() + frameOffset, frames.begin() + endFrameOffset);
+        futures.push_back(submit(firstFrameIndex + frameOffset, subBatchFrames));
+    }
+
+    vector<vector<DetectedObject>> detectedObjectsByFrame;
+    for (auto& subBatchFuture : futures) {
+        for (auto& detectedObjects : subBatchFuture.get()) {
+            detectedObjectsByFrame.push_back(std::move(detectedObjects));
+        }
+    }
+    return detectedObjectsByFrame;
+}
+
+void ObjectDetectorPoolImpl::warmUp() {
+    startIfNecessary();
+
+    // Each replica is warmed up in its own thread, like the detection jobs
+    vector<thread> warmUpThreads;
+    vector<std::exception_ptr> warmUpErrors(replicas.size());
+    for (size_t i = 0; i < replicas.size(); i++) {
+        warmUpThreads.push_back(thread([this, i, &warmUpErrors] {
+            try {
+                replicas[i]->warmUp();
+            } catch (...) {
+                warmUpErrors[i] = std::current_exception();
+            }
+        }));
+    }
+    for (thread& warmUpThread : warmUpThreads) {
+        warmUpThread.join();
+    }
+    for (const std::exception_ptr& warmUpError : warmUpErrors) {
+        if (warmUpError) {
+            std::rethrow_exception(warmUpError);
+        }
+    }
+}
+
+future<vector<vector<DetectedObject>>> ObjectDetectorPoolImpl::submit(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    startIfNecessary();
+
+    DetectionJob detectionJob;
+    detectionJob.firstFrameIndex = firstFrameIndex;
+    detectionJob.frames = frames;
+    auto detectionFuture = detectionJob.promise.get_future();
+
+    if (!detectionJobs.push(std::move(detectionJob))) {
+        throw runtime_error("The object detector pool is closed.");
+    }
+    return detectionFuture;
+}
+
+void ObjectDetectorPoolImpl::startIfNecessary() {
+    std::call_once(startFlag, [this] {
+        int nbThreadsPerReplica = configuration.objectDetectionNbThreadsPerReplica;
+        if (nbThreadsPerReplica <= 0) {
+            nbThreadsPerReplica = max(1, (int) (thread::hardware_concurrency() / replicas.size()));
+        }
+        LOG_INFO(logger) << "Start " << replicas.size() << " object detector replicas with "
+            << nbThreadsPerReplica << " thread(s) each...";
+
+        // Each batch is split among the replicas, so smaller batches leave some replicas idle
+        int batchSize = max(1, configuration.objectDetectionBatchSize);
+        if (batchSize < (int) replicas.size()) {
+            LOG_WARN(logger) << "objectDetection.batchSize (" << batchSize << ") is lower than "
+                << "objectDetection.nbReplicas (" << replicas.size() << "): only " << batchSize
+                << " replica(s) can run at the same time.";
+        }
+
+        // Note: this setting is global to OpenCV, it is not a separate budget per replica. It limits the number
+        // of parallel jobs of each OpenCV call, but the replicas share the same parallel backend, so the total
+        // number of threads depends on this backend (the built-in thread pool of OpenCV is shared by all the
+        // calling threads). It is only applied when the pool is used, so that an unused pool does not change
+        // the budget of other components.
+        cv::setNumThreads(nbThreadsPerReplica);
+
+        for (ObjectDetector* pReplica : replicas) {
+            replicaThreads.push_back(thread([this, pReplica] { runReplica(*pReplica); }));
+        }
+    });
+}
+
+void ObjectDetectorPoolImpl::runReplica(ObjectDetector& replica) {
+    DetectionJob detectionJob;
+    while (detectionJobs.pop(detectionJob)) {
+        try {
+            detectionJob.promise.set_value(
+                replica.detectObjectsAt(detectionJob.firstFrameIndex, detectionJob.frames));
+        } catch (...) {
+            detectionJob.promise.set_exception(std::current_exception());
+        }
+    }
+}
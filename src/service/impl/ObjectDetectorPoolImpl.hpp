@@ -0,0 +1,83 @@
+#ifndef SERVICE_OBJECT_DETECTOR_POOL_IMPL
+#define SERVICE_OBJECT_DETECTOR_POOL_IMPL
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../utils/BoundedQueue.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link ObjectDetector} that distributes the frames among several independent
+     * replicas of another {@link ObjectDetector}, each replica being used by its own thread. On a CPU,
+     * several small networks are faster than one network using all the cores, because the last layers
+     * of YOLO do not scale well with the number of threads.
+     *
+     * Each replica must have its own network. objectDetection.nbThreadsPerReplica is applied with the
+     * process-wide cv::setNumThreads(), so it limits the parallelism of each OpenCV call, not a separate
+     * thread budget per replica.
+     *
+     * @author Marc Plouhinec
+     */
+    class ObjectDetectorPoolImpl : public ObjectDetector {
+        private:
+            struct DetectionJob {
+                int firstFrameIndex = -1;
+                std::vector<cv::Mat> frames;
+                std::promise<std::vector<std::vector<model::DetectedObject>>> promise;
+            };
+
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const std::vector<ObjectDetector*> replicas;
+
+            utils::BoundedQueue<DetectionJob> detectionJobs;
+            std::vector<std::thread> replicaThreads;
+            std::once_flag startFlag;
+
+        public:
+            ObjectDetectorPoolImpl(
+                const model::Configuration& configuration,
+                const std::vector<ObjectDetector*>& replicas);
+
+            virtual ~ObjectDetectorPoolImpl();
+
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame);
+
+            /**
+             * Split the frames into one batch per replica and wait for all the results.
+             */
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+            virtual void warmUp();
+
+            /**
+             * Submit a batch of consecutive frames to the first available replica without waiting.
+             * The batches are started in submission order, but may complete in any order.
+             *
+             * @return The detected objects of each frame, available when the replica is done.
+             */
+            std::future<std::vector<std::vector<model::DetectedObject>>> submit(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+        private:
+            /**
+             * Set the number of OpenCV threads and start the replica threads when the pool is used for the first time.
+             */
+            void startIfNecessary();
+
+            void runReplica(ObjectDetector& replica);
+    };
+
+}
+
+#endif // SERVICE_OBJECT_DETECTOR_POOL_IMPL
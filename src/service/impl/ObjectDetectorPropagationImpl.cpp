@@ -0,0 +1,145 @@
+#include <algorithm>
+#include "ObjectDetectorPropagationImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::vector;
+
+namespace {
+
+    // Each object is followed with a grid of 3 x 3 points
+    const int nbPointsPerSide = 3;
+    const int nbPointsPerObject = nbPointsPerSide * nbPointsPerSide;
+
+    float median(vector<float>& values) {
+        auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+
+}
+
+ObjectDetectorPropagationImpl::~ObjectDetectorPropagationImpl() {
+    int nbFrames = nbDetectedFrames + nbPropagatedFrames;
+    if (nbFrames > 0) {
+        LOG_INFO(logger) << "Objects detected in " << nbDetectedFrames << " frames and propagated in "
+            << nbPropagatedFrames << " frames (" << (100.0 * nbPropagatedFrames / nbFrames) << "%), "
+            << nbLostObjectDetections << " detections because an object was lost.";
+    }
+}
+
+vector<DetectedObject> ObjectDetectorPropagationImpl::detectObjectsAt(int frameIndex, const cv::Mat& frame) {
+    return detectObjectsAt(frameIndex, vector<cv::Mat>{ frame })[0];
+}
+
+void ObjectDetectorPropagationImpl::warmUp() {
+    wrappedObjectDetector.warmUp();
+}
+
+vector<vector<DetectedObject>> ObjectDetectorPropagationImpl::detectObjectsAt(
+    int firstFrameIndex, const vector<cv::Mat>& frames) {
+
+    int keyframeInterval = std::max(1, configuration.objectDetectionKeyframeInterval);
+    vector<vector<DetectedObject>> detectedObjectsByFrame;
+
+    for (size_t frameOffset = 0; frameOffset < frames.size(); frameOffset++) {
+        int frameIndex = firstFrameIndex + frameOffset;
+        const cv::Mat& frame = frames[frameOffset];
+        cv::Mat grayFrame = toDownscaledGrayFrame(frame);
+
+        // Move the objects of the previous frame, unless a detection is necessary
+        bool isKeyframe = frameIndex != previousFrameIndex + 1
+            || frameIndex - lastKeyframeIndex >= keyframeInterval;
+        vector<DetectedObject> detectedObjects;
+        if (!isKeyframe && !propagateObjects(grayFrame, detectedObjects)) {
+            isKeyframe = true;
+            nbLostObjectDetections++;
+        }
+
+        if (isKeyframe) {
+            detectedObjects = wrappedObjectDetector.detectObjectsAt(frameIndex, frame);
+            lastKeyframeIndex = frameIndex;
+            keyframeDetectedObjects = detectedObjects;
+            nbDetectedFrames++;
+        } else {
+            nbPropagatedFrames++;
+        }
+
+        previousFrameIndex = frameIndex;
+        previousGrayFrame = grayFrame;
+        previousDetectedObjects = detectedObjects;
+        detectedObjectsByFrame.push_back(std::move(detectedObjects));
+    }
+
+    return detectedObjectsByFrame;
+}
+
+cv::Mat ObjectDetectorPropagationImpl::toDownscaledGrayFrame(const cv::Mat& frame) const {
+    double scale = configuration.objectDetectionPropagationScale;
+    cv::Mat grayFrame;
+    cv::cvtColor(frame, grayFrame, cv::COLOR_BGR2GRAY);
+    if (scale > 0 && scale < 1) {
+        cv::Mat downscaledGrayFrame;
+        cv::resize(grayFrame, downscaledGrayFrame, cv::Size(), scale, scale, cv::INTER_AREA);
+        return downscaledGrayFrame;
+    }
+    return grayFrame;
+}
+
+bool ObjectDetectorPropagationImpl::propagateObjects(
+    const cv::Mat& grayFrame, vector<DetectedObject>& propagatedObjects) const {
+
+    if (previousDetectedObjects.empty()) {
+        return true;
+    }
+
+    // Follow a grid of points inside each object
+    double scale = configuration.objectDetectionPropagationScale;
+    if (scale <= 0 || scale >= 1) {
+        scale = 1;
+    }
+    vector<cv::Point2f> previousPoints;
+    for (const DetectedObject& detectedObject : previousDetectedObjects) {
+        for (int row = 1; row <= nbPointsPerSide; row++) {
+            for (int column = 1; column <= nbPointsPerSide; column++) {
+                previousPoints.emplace_back(
+                    (detectedObject.x + detectedObject.width * column / (nbPointsPerSide + 1)) * scale,
+                    (detectedObject.y + detectedObject.height * row / (nbPointsPerSide + 1)) * scale);
+            }
+        }
+    }
+
+    vector<cv::Point2f> points;
+    vector<uchar> statuses;
+    vector<float> errors;
+    cv::calcOpticalFlowPyrLK(previousGrayFrame, grayFrame, previousPoints, points, statuses, errors);
+
+    // Move each object by the median displacement of its points
+    double minTrackedRatio = configuration.objectDetectionPropagationMinTrackedRatio;
+    vector<float> dxs;
+    vector<float> dys;
+    for (size_t objectIndex = 0; objectIndex < previousDetectedObjects.size(); objectIndex++) {
+        dxs.clear();
+        dys.clear();
+        for (int i = objectIndex * nbPointsPerObject; i < (int) (objectIndex + 1) * nbPointsPerObject; i++) {
+            if (statuses[i]) {
+                dxs.push_back(points[i].x - previousPoints[i].x);
+                dys.push_back(points[i].y - previousPoints[i].y);
+            }
+        }
+
+        double trackedRatio = (double) dxs.size() / nbPointsPerObject;
+        if (dxs.empty() || trackedRatio < minTrackedRatio) {
+            return false;
+        }
+
+        DetectedObject propagatedObject = previousDetectedObjects[objectIndex].copyAndTranslate(
+            median(dxs) / scale, median(dys) / scale);
+        // Note: the confidence is derived from the keyframe, so it does not decrease at each propagated frame
+        propagatedObject.confidence = keyframeDetectedObjects[objectIndex].confidence * trackedRatio;
+        propagatedObject.isPropagated = true;
+        propagatedObjects.push_back(propagatedObject);
+    }
+
+    return true;
+}
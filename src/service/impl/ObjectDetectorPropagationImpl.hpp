@@ -0,0 +1,73 @@
+#ifndef SERVICE_OBJECT_DETECTOR_PROPAGATION_IMPL
+#define SERVICE_OBJECT_DETECTOR_PROPAGATION_IMPL
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link ObjectDetector} that wraps another {@link ObjectDetector} and only
+     * calls it on keyframes (one frame every objectDetection.keyframeInterval frames).
+     *
+     * On the other frames, the objects of the previous frame are moved according to a sparse optical flow
+     * (Lucas-Kanade) computed on downscaled grayscale frames. These objects are marked as propagated.
+     * When an object cannot be followed anymore, the wrapped detector is called on the current frame.
+     *
+     * Note: frames must be requested in increasing order; any jump triggers a detection.
+     *
+     * @author Marc Plouhinec
+     */
+    class ObjectDetectorPropagationImpl : public ObjectDetector {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            ObjectDetector& wrappedObjectDetector;
+
+            int previousFrameIndex = -2;
+            int lastKeyframeIndex = -1;
+            cv::Mat previousGrayFrame;
+            std::vector<model::DetectedObject> previousDetectedObjects;
+            // Objects detected on the last keyframe, in the same order as previousDetectedObjects
+            std::vector<model::DetectedObject> keyframeDetectedObjects;
+
+            int nbDetectedFrames = 0;
+            int nbPropagatedFrames = 0;
+            int nbLostObjectDetections = 0;
+
+        public:
+            ObjectDetectorPropagationImpl(
+                const model::Configuration& configuration,
+                ObjectDetector& wrappedObjectDetector) :
+                    configuration(configuration),
+                    wrappedObjectDetector(wrappedObjectDetector) {}
+
+            virtual ~ObjectDetectorPropagationImpl();
+
+            virtual std::vector<model::DetectedObject> detectObjectsAt(int frameIndex, const cv::Mat& frame);
+
+            virtual std::vector<std::vector<model::DetectedObject>> detectObjectsAt(
+                int firstFrameIndex, const std::vector<cv::Mat>& frames);
+
+            virtual void warmUp();
+
+        private:
+            cv::Mat toDownscaledGrayFrame(const cv::Mat& frame) const;
+
+            /**
+             * Move the objects of the previous frame to the given frame.
+             *
+             * @return false if at least one object cannot be followed.
+             */
+            bool propagateObjects(
+                const cv::Mat& grayFrame,
+                std::vector<model::DetectedObject>& propagatedObjects) const;
+    };
+
+}
+
+#endif // SERVICE_OBJECT_DETECTOR_PROPAGATION_IMPL
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <math.h>
+#include <unordered_map>
+#include "RegionOfInterestDetectorImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::list;
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+RegionOfInterestDetectorImpl::~RegionOfInterestDetectorImpl() {
+    int nbFrames = nbFullFrameDetections + nbWindowDetections;
+    if (nbFrames > 0) {
+        LOG_INFO(logger) << "Region of interest detection: " << nbFullFrameDetections << " full frames, "
+            << nbWindowDetections << " frames analyzed by windows ("
+            << (nbWindowDetections > 0 ? (double) nbWindows / nbWindowDetections : 0) << " windows per frame).";
+    }
+}
+
+vector<DetectedObject> RegionOfInterestDetectorImpl::detectObjectsAt(
+    int frameIndex,
+    const cv::Mat& frame,
+    const list<Tip>& tips,
+    const list<Chopstick>& chopsticks,
+    const vector<DetectedObject>& prevDetectedObjects,
+    const FrameOffset accumulatedFrameOffset) {
+
+    vector<cv::Rect> windows;
+    bool isFullFrameDue = lastFullFrameIndex < 0
+        || frameIndex - lastFullFrameIndex >= configuration.objectDetectionRoiFullFramePeriod;
+    if (!isFullFrameDue) {
+        windows = buildWindows(frame.size(), tips, chopsticks, prevDetectedObjects, accumulatedFrameOffset);
+    }
+
+    // Analyze the whole frame when needed
+    if (windows.empty() || (int) windows.size() > configuration.objectDetectionRoiMaxWindows) {
+        lastFullFrameIndex = frameIndex;
+        nbFullFrameDetections++;
+        return fullFrameObjectDetector.detectObjectsAt(frameIndex, frame);
+    }
+
+    // Detect the objects of all the windows in one batch
+    vector<cv::Mat> windowImages;
+    for (const cv::Rect& window : windows) {
+        windowImages.push_back(frame(window));
+    }
+    vector<vector<DetectedObject>> detectedObjectsByWindow =
+        windowObjectDetector.detectObjectsAt(frameIndex, windowImages);
+    nbWindowDetections++;
+    nbWindows += windows.size();
+
+    // Move the objects into the frame coordinates and remove the duplicates
+    vector<DetectedObject> detectedObjects;
+    for (size_t windowIndex = 0; windowIndex < windows.size(); windowIndex++) {
+        const cv::Rect& window = windows[windowIndex];
+        for (const DetectedObject& detectedObject : detectedObjectsByWindow[windowIndex]) {
+            detectedObjects.push_back(detectedObject.copyAndTranslate(window.x, window.y));
+        }
+    }
+    return nonMaximumSuppressor.suppress(detectedObjects);
+}
+
+vector<cv::Rect> RegionOfInterestDetectorImpl::buildWindows(
+    cv::Size frameSize,
+    const list<Tip>& tips,
+    const list<Chopstick>& chopsticks,
+    const vector<DetectedObject>& prevDetectedObjects,
+    const FrameOffset accumulatedFrameOffset) const {
+
+    // Tracked objects are compensated for camera motion, so they must be moved back into the frame
+    vector<cv::Rect> windows;
+    unordered_map<string, Rectangle> tipBoxById;
+    for (const Tip& tip : tips) {
+        Rectangle tipBox(
+            tip.x + accumulatedFrameOffset.dx, tip.y + accumulatedFrameOffset.dy, tip.width, tip.height);
+        tipBoxById[tip.id] = tipBox;
+        windows.push_back(buildWindow(tipBox, frameSize));
+    }
+    for (const Chopstick& chopstick : chopsticks) {
+        auto tip1BoxIterator = tipBoxById.find(chopstick.tip1Id);
+        auto tip2BoxIterator = tipBoxById.find(chopstick.tip2Id);
+        if (tip1BoxIterator != tipBoxById.end() && tip2BoxIterator != tipBoxById.end()) {
+            windows.push_back(buildWindow(
+                Rectangle::getBoundingBox(tip1BoxIterator->second, tip2BoxIterator->second), frameSize));
+        }
+    }
+    for (const DetectedObject& detectedObject : prevDetectedObjects) {
+        if (detectedObject.objectType == DetectedObjectType::ARM) {
+            windows.push_back(buildWindow(detectedObject, frameSize));
+        }
+    }
+
+    // Ignore the objects outside of the frame, then merge the windows that overlap until none of them overlap
+    windows.erase(
+        std::remove_if(windows.begin(), windows.end(), [](const cv::Rect& window) { return window.area() <= 0; }),
+        windows.end());
+    bool isMerged = true;
+    while (isMerged) {
+        isMerged = false;
+        for (size_t i = 0; i < windows.size() && !isMerged; i++) {
+            for (size_t j = i + 1; j < windows.size() && !isMerged; j++) {
+                if ((windows[i] & windows[j]).area() > 0) {
+                    windows[i] = windows[i] | windows[j];
+                    windows.erase(windows.begin() + j);
+                    isMerged = true;
+                }
+            }
+        }
+    }
+
+    return windows;
+}
+
+cv::Rect RegionOfInterestDetectorImpl::buildWindow(const Rectangle& objectBox, cv::Size frameSize) const {
+    // Square window centered on the object, with a margin for its motion
+    double size = std::max(
+        (double) configuration.objectDetectionRoiMinWindowSize,
+        std::max(objectBox.width, objectBox.height) * configuration.objectDetectionRoiWindowScale);
+    double centerX = objectBox.x + objectBox.width / 2;
+    double centerY = objectBox.y + objectBox.height / 2;
+
+    int x1 = std::max(0, (int) std::floor(centerX - size / 2));
+    int y1 = std::max(0, (int) std::floor(centerY - size / 2));
+    int x2 = std::min(frameSize.width, (int) std::ceil(centerX + size / 2));
+    int y2 = std::min(frameSize.height, (int) std::ceil(centerY + size / 2));
+    if (x2 <= x1 || y2 <= y1) {
+        return cv::Rect();
+    }
+    return cv::Rect(x1, y1, x2 - x1, y2 - y1);
+}
@@ -0,0 +1,80 @@
+#ifndef SERVICE_REGION_OF_INTEREST_DETECTOR_IMPL
+#define SERVICE_REGION_OF_INTEREST_DETECTOR_IMPL
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../../utils/NonMaximumSuppressor.hpp"
+#include "../ObjectDetector.hpp"
+#include "../RegionOfInterestDetector.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link RegionOfInterestDetector} that crops square windows around the tracked
+     * objects (windows that overlap are merged), detects the objects of all the windows in one batch, then
+     * translates them back into the frame and removes the duplicates.
+     *
+     * The whole frame is analyzed every objectDetection.roiFullFramePeriod frames in order to find new
+     * objects, as well as when nothing is tracked or when there are more than objectDetection.roiMaxWindows
+     * windows.
+     *
+     * @author Marc Plouhinec
+     */
+    class RegionOfInterestDetectorImpl : public RegionOfInterestDetector {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            ObjectDetector& fullFrameObjectDetector;
+            ObjectDetector& windowObjectDetector;
+            utils::NonMaximumSuppressor nonMaximumSuppressor;
+
+            int lastFullFrameIndex = -1;
+            int nbFullFrameDetections = 0;
+            int nbWindowDetections = 0;
+            long nbWindows = 0;
+
+        public:
+            /**
+             * @param fullFrameObjectDetector Detector used for the whole frames.
+             * @param windowObjectDetector Detector used for the windows (without cache, since the images
+             *                             are not whole frames).
+             */
+            RegionOfInterestDetectorImpl(
+                const model::Configuration& configuration,
+                ObjectDetector& fullFrameObjectDetector,
+                ObjectDetector& windowObjectDetector) :
+                    configuration(configuration),
+                    fullFrameObjectDetector(fullFrameObjectDetector),
+                    windowObjectDetector(windowObjectDetector),
+                    nonMaximumSuppressor(configuration.objectDetectionNmsThreshold) {}
+
+            virtual ~RegionOfInterestDetectorImpl();
+
+            virtual std::vector<model::DetectedObject> detectObjectsAt(
+                int frameIndex,
+                const cv::Mat& frame,
+                const std::list<model::Tip>& tips,
+                const std::list<model::Chopstick>& chopsticks,
+                const std::vector<model::DetectedObject>& prevDetectedObjects,
+                const model::FrameOffset accumulatedFrameOffset);
+
+        private:
+            /**
+             * @return Windows covering the tracked objects, inside the frame and without overlap.
+             */
+            std::vector<cv::Rect> buildWindows(
+                cv::Size frameSize,
+                const std::list<model::Tip>& tips,
+                const std::list<model::Chopstick>& chopsticks,
+                const std::vector<model::DetectedObject>& prevDetectedObjects,
+                const model::FrameOffset accumulatedFrameOffset) const;
+
+            cv::Rect buildWindow(const model::Rectangle& objectBox, cv::Size frameSize) const;
+    };
+
+}
+
+#endif // SERVICE_REGION_OF_INTEREST_DETECTOR_IMPL
@@ -1,5 +1,6 @@
 #include "VideoFramePainterDetectedObjectsImpl.hpp"
 
+#include <algorithm>
 #include <math.h>
 
 using namespace model;
@@ -45,13 +46,36 @@ void VideoFramePainterDetectedObjectsImpl::paintOnFrame(
                 break;
         }
 
-        cv::rectangle(
-            frame,
-            cv::Rect(
-                round(detectedObject.x + frameMargin - accumulatedFrameOffset.dx),
-                round(detectedObject.y + frameMargin - accumulatedFrameOffset.dy),
-                detectedObject.width,
-                detectedObject.height),
-            color);
+        cv::Rect rectangle(
+            round(detectedObject.x + frameMargin - accumulatedFrameOffset.dx),
+            round(detectedObject.y + frameMargin - accumulatedFrameOffset.dy),
+            detectedObject.width,
+            detectedObject.height);
+        if (detectedObject.isPropagated) {
+            // Objects moved from a previous frame are only drawn with their corners
+            paintCorners(frame, rectangle, color);
+        } else {
+            cv::rectangle(frame, rectangle, color);
+        }
     }
+}
+
+void VideoFramePainterDetectedObjectsImpl::paintCorners(
+    const cv::Mat& frame, const cv::Rect& rectangle, const cv::Scalar& color) const {
+
+    int cornerWidth = std::max(1, rectangle.width / 4);
+    int cornerHeight = std::max(1, rectangle.height / 4);
+    int left = rectangle.x;
+    int top = rectangle.y;
+    int right = rectangle.x + rectangle.width;
+    int bottom = rectangle.y + rectangle.height;
+
+    cv::line(frame, cv::Point(left, top), cv::Point(left + cornerWidth, top), color);
+    cv::line(frame, cv::Point(left, top), cv::Point(left, top + cornerHeight), color);
+    cv::line(frame, cv::Point(right, top), cv::Point(right - cornerWidth, top), color);
+    cv::line(frame, cv::Point(right, top), cv::Point(right, top + cornerHeight), color);
+    cv::line(frame, cv::Point(left, bottom), cv::Point(left + cornerWidth, bottom), color);
+    cv::line(frame, cv::Point(left, bottom), cv::Point(left, bottom - cornerHeight), color);
+    cv::line(frame, cv::Point(right, bottom), cv::Point(right - cornerWidth, bottom), color);
+    cv::line(frame, cv::Point(right, bottom), cv::Point(right, bottom - cornerHeight), color);
 }
\ No newline at end of file
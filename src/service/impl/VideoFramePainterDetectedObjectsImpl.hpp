@@ -26,6 +26,9 @@ namespace service {
                 const cv::Mat& frame,
                 const std::vector<model::DetectedObject>& detectedObjects,
                 const model::FrameOffset accumulatedFrameOffset) const;
+
+        private:
+            void paintCorners(const cv::Mat& frame, const cv::Rect& rectangle, const cv::Scalar& color) const;
     };
 
 }
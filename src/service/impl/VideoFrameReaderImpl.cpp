@@ -13,6 +13,9 @@ using std::to_string;
 using std::out_of_range;
 using std::runtime_error;
 
+// Minimum number of frames that a forward seek must skip, because it restarts the decoder
+static const int MIN_NB_FRAMES_SKIPPED_BY_SEEK = 16;
+
 VideoFrameReaderImpl::~VideoFrameReaderImpl() {
     if (pVideoCapture) {
         pVideoCapture->release();
@@ -26,12 +29,15 @@ const cv::Mat VideoFrameReaderImpl::readFrameAt(int frameIndex) {
 
     initVideoCaptureIfNecessary();
 
-    // Rewind if necessary
-    if (frameIndex < currentFrameIndex) {
-        currentFrameIndex = max(0, frameIndex - 20);
-        pVideoCapture->set(cv::CAP_PROP_POS_FRAMES, currentFrameIndex);
-        // Note: we cannot rewind to the exact position because FFMpeg (used by OpenCV)
-        // has some trouble when the frameIndex doesn't point exactly to a key frame.
+    // Rewind if necessary, or jump forward when a keyframe allows us to skip enough frames to be worth
+    // flushing the decoder (sequential reads just continue decoding, even across keyframes).
+    // Note: we always seek to a keyframe because FFMpeg (used by OpenCV) has some trouble when the
+    // position doesn't point exactly to a keyframe.
+    int keyframeIndexBeforeFrame = keyframeIndex.findKeyframeAtOrBefore(frameIndex);
+    if (frameIndex < currentFrameIndex
+        || keyframeIndexBeforeFrame > currentFrameIndex + MIN_NB_FRAMES_SKIPPED_BY_SEEK) {
+        pVideoCapture->set(cv::CAP_PROP_POS_FRAMES, keyframeIndexBeforeFrame);
+        currentFrameIndex = keyframeIndexBeforeFrame - 1;
     }
 
     // Read the frame image
@@ -43,6 +49,8 @@ const cv::Mat VideoFrameReaderImpl::readFrameAt(int frameIndex) {
         }
 
         if (currentFrameIndex == frameIndex) {
+            // Release the previous frame first, so it is not overwritten if the caller still uses it
+            currentFrame.release();
             pVideoCapture->retrieve(currentFrame);
         }
     }
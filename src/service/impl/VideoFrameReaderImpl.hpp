@@ -3,6 +3,7 @@
 
 #include <memory>
 #include "../../model/Configuration.hpp"
+#include "../../utils/KeyframeIndex.hpp"
 #include "../VideoFrameReader.hpp"
 
 namespace service {
@@ -11,6 +12,7 @@ namespace service {
         private:
             const model::Configuration& configuration;
             const boost::filesystem::path& videoPath;
+            const utils::KeyframeIndex& keyframeIndex;
 
             cv::Mat currentFrame;
             int currentFrameIndex = -1;
@@ -20,9 +22,11 @@ namespace service {
         public:
             VideoFrameReaderImpl(
                 const model::Configuration& configuration,
-                boost::filesystem::path& videoPath) :
+                boost::filesystem::path& videoPath,
+                const utils::KeyframeIndex& keyframeIndex) :
                     configuration(configuration),
-                    videoPath(videoPath) {}
+                    videoPath(videoPath),
+                    keyframeIndex(keyframeIndex) {}
 
             virtual ~VideoFrameReaderImpl();
 
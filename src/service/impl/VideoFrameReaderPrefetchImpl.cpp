@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include "VideoFrameReaderPrefetchImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::lock_guard;
+using std::mutex;
+using std::out_of_range;
+using std::thread;
+using std::to_string;
+using std::unique_lock;
+namespace chrono = std::chrono;
+
+VideoFrameReaderPrefetchImpl::~VideoFrameReaderPrefetchImpl() {
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        stopped = true;
+    }
+    frameConsumedCondition.notify_all();
+    if (decodingThread.joinable()) {
+        decodingThread.join();
+    }
+
+    if (nbReads > 0) {
+        LOG_INFO(logger) << "Prefetching video reader: " << nbReads << " reads, " << nbStalls << " stalls ("
+            << (100.0 * nbStalls / nbReads) << "%), total stall time = " << totalStallTimeMs << " ms.";
+    }
+}
+
+const cv::Mat VideoFrameReaderPrefetchImpl::readFrameAt(int frameIndex) {
+    unique_lock<mutex> lock(bufferMutex);
+
+    // Start the decoder during the first call
+    if (!decodingThread.joinable()) {
+        videoProperties = decoder.getVideoProperties();
+        decodingThread = thread([this] { decodeFrames(); });
+    }
+    nbReads++;
+
+    if (frameIndex < 0 || frameIndex >= videoProperties.nbFrames) {
+        throw out_of_range("Unable to read the frame " + to_string(frameIndex) + ".");
+    }
+
+    // Move the decoder if the frame is not in the buffer and will not be there soon
+    int endBufferedFrameIndex = firstBufferedFrameIndex + bufferedFrames.size();
+    if (frameIndex < firstBufferedFrameIndex || frameIndex > endBufferedFrameIndex + prefetchDepth) {
+        bufferedFrames.clear();
+        firstBufferedFrameIndex = frameIndex;
+        nextFrameIndexToDecode = frameIndex;
+        decodingError = nullptr;
+        seekGeneration++;
+        frameConsumedCondition.notify_one();
+    }
+
+    bool stalled = false;
+    auto stallStartTime = chrono::steady_clock::now();
+    while (true) {
+        // Discard the frames before the requested one, so the decoder can continue
+        bool framesDiscarded = false;
+        while (firstBufferedFrameIndex < frameIndex && !bufferedFrames.empty()) {
+            bufferedFrames.pop_front();
+            firstBufferedFrameIndex++;
+            framesDiscarded = true;
+        }
+        if (framesDiscarded) {
+            frameConsumedCondition.notify_one();
+        }
+
+        if (frameIndex == firstBufferedFrameIndex && !bufferedFrames.empty()) {
+            break;
+        }
+        if (decodingError) {
+            std::rethrow_exception(decodingError);
+        }
+
+        stalled = true;
+        frameDecodedCondition.wait(lock);
+    }
+
+    if (stalled) {
+        nbStalls++;
+        totalStallTimeMs += chrono::duration<double, std::milli>(chrono::steady_clock::now() - stallStartTime).count();
+    }
+    return bufferedFrames.front();
+}
+
+const VideoProperties VideoFrameReaderPrefetchImpl::getVideoProperties() {
+    lock_guard<mutex> lock(bufferMutex);
+    if (!decodingThread.joinable()) {
+        videoProperties = decoder.getVideoProperties();
+    }
+    return videoProperties;
+}
+
+void VideoFrameReaderPrefetchImpl::decodeFrames() {
+    unique_lock<mutex> lock(bufferMutex);
+    while (true) {
+        frameConsumedCondition.wait(lock, [this] {
+            return stopped || (!decodingError
+                && (int) bufferedFrames.size() < prefetchDepth
+                && nextFrameIndexToDecode < videoProperties.nbFrames);
+        });
+        if (stopped) {
+            return;
+        }
+
+        // Decode the next frame without blocking the consumer
+        int frameIndex = nextFrameIndexToDecode;
+        int generation = seekGeneration;
+        lock.unlock();
+
+        cv::Mat frame;
+        std::exception_ptr error;
+        try {
+            frame = decoder.readFrameAt(frameIndex);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        if (generation != seekGeneration) {
+            // The consumer moved to another position in the meantime
+            continue;
+        }
+        if (error) {
+            decodingError = error;
+        } else {
+            bufferedFrames.push_back(frame);
+            nextFrameIndexToDecode++;
+        }
+        frameDecodedCondition.notify_all();
+    }
+}
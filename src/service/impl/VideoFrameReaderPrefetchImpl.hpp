@@ -0,0 +1,72 @@
+#ifndef SERVICE_VIDEO_FRAME_READER_PREFETCH_IMPL
+#define SERVICE_VIDEO_FRAME_READER_PREFETCH_IMPL
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <boost/filesystem.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../VideoFrameReader.hpp"
+#include "VideoFrameReaderImpl.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoFrameReader} that decodes the frames in a background thread with
+     * a {@link VideoFrameReaderImpl}, ahead of the consumer. Up to inputVideo.prefetchDepth decoded
+     * (and cropped) frames are kept in a ring buffer, so decoding overlaps with the other steps.
+     *
+     * Frames are expected to be read in increasing order: reading a frame discards the previous ones from
+     * the buffer. Reading a frame before the buffer or far after it makes the decoder seek to this frame.
+     *
+     * The number of times the consumer had to wait for the decoder is logged when this reader is destroyed.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoFrameReaderPrefetchImpl : public VideoFrameReader {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const int prefetchDepth;
+            VideoFrameReaderImpl decoder;
+            model::VideoProperties videoProperties;
+
+            std::mutex bufferMutex;
+            std::condition_variable frameDecodedCondition;
+            std::condition_variable frameConsumedCondition;
+            std::deque<cv::Mat> bufferedFrames;
+            int firstBufferedFrameIndex = 0;
+            int nextFrameIndexToDecode = 0;
+            int seekGeneration = 0;
+            std::exception_ptr decodingError;
+            bool stopped = false;
+            std::thread decodingThread;
+
+            long nbReads = 0;
+            long nbStalls = 0;
+            double totalStallTimeMs = 0;
+
+        public:
+            VideoFrameReaderPrefetchImpl(
+                const model::Configuration& configuration,
+                boost::filesystem::path& videoPath,
+                const utils::KeyframeIndex& keyframeIndex) :
+                    prefetchDepth(std::max(1, configuration.inputVideoPrefetchDepth)),
+                    decoder(configuration, videoPath, keyframeIndex) {}
+
+            virtual ~VideoFrameReaderPrefetchImpl();
+
+            virtual const cv::Mat readFrameAt(int frameIndex);
+            virtual const model::VideoProperties getVideoProperties();
+
+        private:
+            void decodeFrames();
+    };
+
+}
+
+#endif // SERVICE_VIDEO_FRAME_READER_PREFETCH_IMPL
@@ -0,0 +1,176 @@
+#include <chrono>
+#include <stdexcept>
+#include "VideoFrameWriterAsyncImpl.hpp"
+
+using namespace service;
+using std::lock_guard;
+using std::make_pair;
+using std::mutex;
+using std::pair;
+using std::thread;
+using std::unique_lock;
+namespace chrono = std::chrono;
+
+VideoFrameWriterAsyncImpl::VideoFrameWriterAsyncImpl(
+    const model::Configuration& configuration,
+    VideoFrameWriter& wrappedVideoFrameWriter) :
+        wrappedVideoFrameWriter(wrappedVideoFrameWriter) {
+
+    int poolSize = configuration.renderingAsyncWriterPoolSize;
+    LOG_INFO(logger) << "Preallocate " << poolSize << " output frames...";
+    for (int bufferIndex = 0; bufferIndex < poolSize; bufferIndex++) {
+        bufferPool.push_back(wrappedVideoFrameWriter.buildOutputFrame());
+        freeBufferIndexes.push_back(bufferIndex);
+    }
+    isBufferHeldByCaller.resize(poolSize, false);
+
+    writingThread = thread(&VideoFrameWriterAsyncImpl::writePendingFrames, this);
+}
+
+VideoFrameWriterAsyncImpl::~VideoFrameWriterAsyncImpl() {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        stopping = true;
+    }
+    pendingFrameCondition.notify_all();
+    writingThread.join();
+
+    if (writingError) {
+        LOG_ERROR(logger) << "Some frames could not be written.";
+    }
+    LOG_INFO(logger) << "Total time spent waiting for a free output frame: " << totalWaitForBufferTimeMs << " ms.";
+}
+
+cv::Mat VideoFrameWriterAsyncImpl::buildOutputFrame() {
+    unique_lock<mutex> lock(poolMutex);
+    int bufferIndex = acquireFreeBufferIndex(lock);
+    isBufferHeldByCaller[bufferIndex] = true;
+    return bufferPool[bufferIndex];
+}
+
+void VideoFrameWriterAsyncImpl::writeFrameAt(int frameIndex, cv::Mat& frame) {
+    unique_lock<mutex> lock(poolMutex);
+    if (writingError) {
+        // Note: the frames written after an error are dropped
+        std::rethrow_exception(writingError);
+    }
+
+    // Copy the frame if it doesn't come from the pool
+    int bufferIndex = findBufferIndex(frame);
+    if (bufferIndex == -1) {
+        bufferIndex = acquireFreeBufferIndex(lock);
+        frame.copyTo(bufferPool[bufferIndex]);
+    }
+    isBufferHeldByCaller[bufferIndex] = false;
+
+    pendingFrameAndBufferIndexes.push_back(make_pair(frameIndex, bufferIndex));
+    lock.unlock();
+    pendingFrameCondition.notify_one();
+}
+
+void VideoFrameWriterAsyncImpl::discardOutputFrame(cv::Mat& frame) {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        int bufferIndex = findBufferIndex(frame);
+        if (bufferIndex == -1 || !isBufferHeldByCaller[bufferIndex]) {
+            return;
+        }
+        isBufferHeldByCaller[bufferIndex] = false;
+        freeBufferIndexes.push_back(bufferIndex);
+    }
+    freeBufferCondition.notify_all();
+}
+
+void VideoFrameWriterAsyncImpl::flush() {
+    unique_lock<mutex> lock(poolMutex);
+    flushedCondition.wait(lock, [this] {
+        return writingError || (pendingFrameAndBufferIndexes.empty() && !writingFrame);
+    });
+    if (writingError) {
+        std::rethrow_exception(writingError);
+    }
+    lock.unlock();
+
+    wrappedVideoFrameWriter.flush();
+}
+
+void VideoFrameWriterAsyncImpl::cancel() {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        if (!writingError) {
+            writingError = std::make_exception_ptr(std::runtime_error("The video writing was cancelled."));
+        }
+        for (auto& pendingFrameAndBufferIndex : pendingFrameAndBufferIndexes) {
+            freeBufferIndexes.push_back(pendingFrameAndBufferIndex.second);
+        }
+        pendingFrameAndBufferIndexes.clear();
+    }
+    freeBufferCondition.notify_all();
+    flushedCondition.notify_all();
+    wrappedVideoFrameWriter.cancel();
+}
+
+void VideoFrameWriterAsyncImpl::writePendingFrames() {
+    unique_lock<mutex> lock(poolMutex);
+
+    while (true) {
+        pendingFrameCondition.wait(lock, [this] {
+            return stopping || !pendingFrameAndBufferIndexes.empty();
+        });
+        if (pendingFrameAndBufferIndexes.empty()) {
+            return;
+        }
+
+        pair<int, int> frameAndBufferIndex = pendingFrameAndBufferIndexes.front();
+        pendingFrameAndBufferIndexes.pop_front();
+        writingFrame = true;
+        lock.unlock();
+
+        try {
+            wrappedVideoFrameWriter.writeFrameAt(
+                frameAndBufferIndex.first, bufferPool[frameAndBufferIndex.second]);
+        } catch (...) {
+            lock.lock();
+            writingError = std::current_exception();
+            for (auto& pendingFrameAndBufferIndex : pendingFrameAndBufferIndexes) {
+                freeBufferIndexes.push_back(pendingFrameAndBufferIndex.second);
+            }
+            pendingFrameAndBufferIndexes.clear();
+            lock.unlock();
+        }
+
+        lock.lock();
+        writingFrame = false;
+        freeBufferIndexes.push_back(frameAndBufferIndex.second);
+        freeBufferCondition.notify_all();
+        flushedCondition.notify_all();
+    }
+}
+
+int VideoFrameWriterAsyncImpl::acquireFreeBufferIndex(unique_lock<mutex>& lock) {
+    if (freeBufferIndexes.empty()) {
+        auto startTime = chrono::steady_clock::now();
+        freeBufferCondition.wait(lock, [this] {
+            return writingError || !freeBufferIndexes.empty();
+        });
+        totalWaitForBufferTimeMs +=
+            chrono::duration<double, std::milli>(chrono::steady_clock::now() - startTime).count();
+    }
+    if (freeBufferIndexes.empty()) {
+        // Woken up by an error while all the buffers are held by the callers
+        std::rethrow_exception(writingError);
+    }
+
+    int bufferIndex = freeBufferIndexes.front();
+    freeBufferIndexes.pop_front();
+    return bufferIndex;
+}
+
+int VideoFrameWriterAsyncImpl::findBufferIndex(const cv::Mat& frame) const {
+    for (size_t bufferIndex = 0; bufferIndex < bufferPool.size(); bufferIndex++) {
+        if (bufferPool[bufferIndex].data == frame.data) {
+            return bufferIndex;
+        }
+    }
+    return -1;
+}
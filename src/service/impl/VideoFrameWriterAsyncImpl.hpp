@@ -0,0 +1,78 @@
+#ifndef SERVICE_VIDEO_FRAME_WRITER_ASYNC_IMPL
+#define SERVICE_VIDEO_FRAME_WRITER_ASYNC_IMPL
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../VideoFrameWriter.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoFrameWriter} that wraps another {@link VideoFrameWriter}
+     * in order to encode and write the frames in a background thread.
+     *
+     * The output frames are taken from a pool of preallocated buffers: {@link #buildOutputFrame()}
+     * returns a free buffer and blocks when all of them are being painted or waiting to be written.
+     * A buffer becomes free again once the wrapped writer has written it, so the caller must not use
+     * a frame after having passed it to {@link #writeFrameAt(int, cv::Mat&)}, and must give it back with
+     * {@link #discardOutputFrame(cv::Mat&)} if it is not written.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoFrameWriterAsyncImpl : public VideoFrameWriter {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            VideoFrameWriter& wrappedVideoFrameWriter;
+
+            std::vector<cv::Mat> bufferPool;
+            std::deque<int> freeBufferIndexes;
+            std::vector<bool> isBufferHeldByCaller;
+            std::deque<std::pair<int, int>> pendingFrameAndBufferIndexes;
+            bool writingFrame = false;
+            bool stopping = false;
+            std::exception_ptr writingError;
+
+            std::mutex poolMutex;
+            std::condition_variable freeBufferCondition;
+            std::condition_variable pendingFrameCondition;
+            std::condition_variable flushedCondition;
+            std::thread writingThread;
+
+            double totalWaitForBufferTimeMs = 0;
+
+        public:
+            VideoFrameWriterAsyncImpl(
+                const model::Configuration& configuration,
+                VideoFrameWriter& wrappedVideoFrameWriter);
+
+            virtual ~VideoFrameWriterAsyncImpl();
+
+            virtual cv::Mat buildOutputFrame();
+
+            virtual void writeFrameAt(int frameIndex, cv::Mat& frame);
+
+            virtual void discardOutputFrame(cv::Mat& frame);
+
+            virtual void flush();
+
+            virtual void cancel();
+
+        private:
+            void writePendingFrames();
+
+            int acquireFreeBufferIndex(std::unique_lock<std::mutex>& lock);
+
+            int findBufferIndex(const cv::Mat& frame) const;
+    };
+
+}
+
+#endif // SERVICE_VIDEO_FRAME_WRITER_ASYNC_IMPL
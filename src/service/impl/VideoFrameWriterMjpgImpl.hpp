@@ -39,6 +39,12 @@ namespace service {
             virtual cv::Mat buildOutputFrame();
 
             virtual void writeFrameAt(int frameIndex, cv::Mat& frame);
+
+            virtual void discardOutputFrame(cv::Mat& frame) {};
+
+            virtual void flush() {};
+
+            virtual void cancel() {};
     };
 
 }
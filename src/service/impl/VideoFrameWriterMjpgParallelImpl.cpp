@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <stdexcept>
+#include "VideoFrameWriterMjpgParallelImpl.hpp"
+
+using namespace service;
+using std::lock_guard;
+using std::max;
+using std::mutex;
+using std::runtime_error;
+using std::string;
+using std::thread;
+using std::to_string;
+using std::unique_lock;
+using std::vector;
+namespace fs = boost::filesystem;
+
+static int computeNbEncodingThreads(const model::Configuration& configuration) {
+    int nbThreads = configuration.renderingNbEncodingThreads;
+    if (nbThreads <= 0) {
+        nbThreads = max(1, (int) thread::hardware_concurrency());
+    }
+    return nbThreads;
+}
+
+VideoFrameWriterMjpgParallelImpl::VideoFrameWriterMjpgParallelImpl(
+    const model::Configuration& configuration,
+    const fs::path& inputVideoPath,
+    const model::VideoProperties& videoProperties) :
+        configuration(configuration),
+        inputVideoPath(inputVideoPath),
+        outputFps(videoProperties.fps),
+        outputFrameWidth(videoProperties.frameWidth + 2 * configuration.renderingVideoFrameMarginsInPixels),
+        outputFrameHeight(videoProperties.frameHeight + 2 * configuration.renderingVideoFrameMarginsInPixels),
+        nbEncodingThreads(computeNbEncodingThreads(configuration)),
+        encodingJobs(2 * computeNbEncodingThreads(configuration)) {}
+
+VideoFrameWriterMjpgParallelImpl::~VideoFrameWriterMjpgParallelImpl() {
+    encodingJobs.close();
+    for (thread& encodingThread : encodingThreads) {
+        encodingThread.join();
+    }
+
+    // Note: the file is normally finalized by flush(), this is only a fallback when processing failed
+    if (aviMjpegMuxer.isOpen()) {
+        LOG_WARN(logger) << "The output video file was not flushed, finalize it anyway.";
+        try {
+            aviMjpegMuxer.close();
+        } catch (const std::exception& e) {
+            LOG_ERROR(logger) << "Unable to finalize the output video file: " << e.what();
+        }
+    }
+}
+
+cv::Mat VideoFrameWriterMjpgParallelImpl::buildOutputFrame() {
+    return cv::Mat(outputFrameHeight, outputFrameWidth, CV_8UC3);
+}
+
+void VideoFrameWriterMjpgParallelImpl::writeFrameAt(int frameIndex, cv::Mat& frame) {
+    int expectedFrameIndex = lastWrittenFrameIndex + 1;
+    if (expectedFrameIndex != frameIndex) {
+        throw runtime_error("Only sequential write is supported (expected frameIndex = "
+            + to_string(expectedFrameIndex) + ", actual = " + to_string(frameIndex) + ")");
+    }
+
+    if (finalized) {
+        throw runtime_error("The output video file is already finalized.");
+    }
+    if (!aviMjpegMuxer.isOpen()) {
+        initOutputFile();
+    }
+
+    {
+        lock_guard<mutex> lock(muxingMutex);
+        if (encodingError) {
+            std::rethrow_exception(encodingError);
+        }
+    }
+
+    // Copy the frame because the caller may reuse its buffer as soon as this method returns
+    EncodingJob encodingJob;
+    encodingJob.frameIndex = frameIndex;
+    encodingJob.frame = frame.clone();
+    if (!encodingJobs.push(std::move(encodingJob))) {
+        lock_guard<mutex> lock(muxingMutex);
+        std::rethrow_exception(encodingError);
+    }
+    lastWrittenFrameIndex = frameIndex;
+}
+
+void VideoFrameWriterMjpgParallelImpl::flush() {
+    {
+        unique_lock<mutex> lock(muxingMutex);
+        frameMuxedCondition.wait(lock, [this] {
+            return encodingError || nextFrameIndexToMux > lastWrittenFrameIndex;
+        });
+        if (encodingError) {
+            std::rethrow_exception(encodingError);
+        }
+    }
+
+    // All the frames are muxed: stop the encoding threads and write the index of the video file
+    encodingJobs.close();
+    for (thread& encodingThread : encodingThreads) {
+        encodingThread.join();
+    }
+    encodingThreads.clear();
+    finalized = true;
+    if (aviMjpegMuxer.isOpen()) {
+        aviMjpegMuxer.close();
+    }
+}
+
+void VideoFrameWriterMjpgParallelImpl::cancel() {
+    {
+        lock_guard<mutex> lock(muxingMutex);
+        if (!encodingError) {
+            encodingError = std::make_exception_ptr(runtime_error("The video writing was cancelled."));
+        }
+    }
+    encodingJobs.cancel();
+    frameMuxedCondition.notify_all();
+}
+
+void VideoFrameWriterMjpgParallelImpl::initOutputFile() {
+    LOG_INFO(logger) << "Initialize the output video file (encoding threads = " << nbEncodingThreads << ")...";
+
+    string outputVideoFilename = inputVideoPath.stem().string() + ".avi";
+    fs::path outputVideoPath(configuration.renderingOutputPath / outputVideoFilename);
+
+    if (fs::is_directory(outputVideoPath) || fs::exists(outputVideoPath)) {
+        if (!fs::remove(outputVideoPath)) {
+            throw runtime_error("Unable to delete the file: " + outputVideoPath.string());
+        }
+    }
+    fs::path parentPath = outputVideoPath.parent_path();
+    if (!fs::is_directory(parentPath)) {
+        fs::create_directories(parentPath);
+    }
+
+    aviMjpegMuxer.open(outputVideoPath.string(), outputFrameWidth, outputFrameHeight, outputFps);
+
+    for (int i = 0; i < nbEncodingThreads; i++) {
+        encodingThreads.push_back(thread(&VideoFrameWriterMjpgParallelImpl::encodeFrames, this));
+    }
+}
+
+void VideoFrameWriterMjpgParallelImpl::encodeFrames() {
+    EncodingJob encodingJob;
+    while (encodingJobs.pop(encodingJob)) {
+        try {
+            vector<unsigned char> jpegData;
+            if (!cv::imencode(".jpg", encodingJob.frame, jpegData)) {
+                throw runtime_error("Unable to encode the frame " + to_string(encodingJob.frameIndex) + ".");
+            }
+            encodingJob.frame.release();
+
+            // Write the encoded frames that are next in the sequence
+            lock_guard<mutex> lock(muxingMutex);
+            encodedFramesByIndex.emplace(encodingJob.frameIndex, std::move(jpegData));
+            auto frameIterator = encodedFramesByIndex.find(nextFrameIndexToMux);
+            while (frameIterator != encodedFramesByIndex.end()) {
+                aviMjpegMuxer.writeFrame(frameIterator->second);
+                encodedFramesByIndex.erase(frameIterator);
+                nextFrameIndexToMux++;
+                frameIterator = encodedFramesByIndex.find(nextFrameIndexToMux);
+            }
+        } catch (...) {
+            LOG_ERROR(logger) << "Unable to write the frame " << encodingJob.frameIndex << ".";
+            {
+                lock_guard<mutex> lock(muxingMutex);
+                if (!encodingError) {
+                    encodingError = std::current_exception();
+                }
+            }
+            encodingJobs.cancel();
+        }
+        frameMuxedCondition.notify_all();
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef SERVICE_VIDEO_FRAME_WRITER_MJPG_PARALLEL_IMPL
+#define SERVICE_VIDEO_FRAME_WRITER_MJPG_PARALLEL_IMPL
+
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../model/VideoProperties.hpp"
+#include "../../utils/AviMjpegMuxer.hpp"
+#include "../../utils/BoundedQueue.hpp"
+#include "../../utils/logging.hpp"
+#include "../VideoFrameWriter.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoFrameWriter} that generates the same kind of .avi file as
+     * {@link VideoFrameWriterMjpgImpl}, but encodes the frames into JPEG images with several threads.
+     * The encoded images are then written in order by {@link utils::AviMjpegMuxer}.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoFrameWriterMjpgParallelImpl : public VideoFrameWriter {
+        private:
+            struct EncodingJob {
+                int frameIndex = -1;
+                cv::Mat frame;
+            };
+
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const boost::filesystem::path& inputVideoPath;
+            const int outputFps;
+            const int outputFrameWidth;
+            const int outputFrameHeight;
+            const int nbEncodingThreads;
+            int lastWrittenFrameIndex = -1;
+            bool finalized = false;
+
+            utils::BoundedQueue<EncodingJob> encodingJobs;
+            std::vector<std::thread> encodingThreads;
+
+            std::mutex muxingMutex;
+            std::condition_variable frameMuxedCondition;
+            utils::AviMjpegMuxer aviMjpegMuxer;
+            std::map<int, std::vector<unsigned char>> encodedFramesByIndex;
+            int nextFrameIndexToMux = 0;
+            std::exception_ptr encodingError;
+
+        public:
+            VideoFrameWriterMjpgParallelImpl(
+                const model::Configuration& configuration,
+                const boost::filesystem::path& inputVideoPath,
+                const model::VideoProperties& videoProperties);
+
+            virtual ~VideoFrameWriterMjpgParallelImpl();
+
+            virtual cv::Mat buildOutputFrame();
+
+            virtual void writeFrameAt(int frameIndex, cv::Mat& frame);
+
+            virtual void discardOutputFrame(cv::Mat& frame) {};
+
+            /**
+             * Wait until all the frames are muxed, then finalize the video file (index and headers).
+             * No frame can be written after this call.
+             */
+            virtual void flush();
+
+            virtual void cancel();
+
+        private:
+            void initOutputFile();
+
+            void encodeFrames();
+    };
+
+}
+
+#endif // SERVICE_VIDEO_FRAME_WRITER_MJPG_PARALLEL_IMPL
@@ -0,0 +1,59 @@
+#include <stdexcept>
+#include <vector>
+#include "VideoFrameWriterMultiJpegArchiveImpl.hpp"
+
+using namespace service;
+using std::runtime_error;
+using std::string;
+using std::to_string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+VideoFrameWriterMultiJpegArchiveImpl::~VideoFrameWriterMultiJpegArchiveImpl() {
+    // Note: the archive is normally closed by flush(), this is only a fallback when processing failed
+    if (jpegArchiveWriter.isOpen()) {
+        LOG_WARN(logger) << "The output archive was not flushed, finalize it anyway.";
+        try {
+            jpegArchiveWriter.close();
+        } catch (const std::exception& e) {
+            LOG_ERROR(logger) << "Unable to finalize the output archive: " << e.what();
+        }
+    }
+}
+
+cv::Mat VideoFrameWriterMultiJpegArchiveImpl::buildOutputFrame() {
+    return cv::Mat(outputFrameHeight, outputFrameWidth, CV_8UC3);
+}
+
+void VideoFrameWriterMultiJpegArchiveImpl::writeFrameAt(int frameIndex, cv::Mat& frame) {
+    if (finalized) {
+        throw runtime_error("The output archive is already finalized.");
+    }
+    if (!jpegArchiveWriter.isOpen()) {
+        LOG_INFO(logger) << "Initialize the output archive...";
+
+        string archiveFilename = inputVideoPath.stem().string() + utils::JpegArchive::FILE_EXTENSION;
+        fs::path archivePath(configuration.renderingOutputPath / archiveFilename);
+
+        backgroundFileRemover.remove(archivePath);
+        fs::path parentPath = archivePath.parent_path();
+        if (!fs::is_directory(parentPath)) {
+            fs::create_directories(parentPath);
+        }
+
+        jpegArchiveWriter.open(archivePath.string());
+    }
+
+    vector<unsigned char> jpegData;
+    if (!cv::imencode(".jpg", frame, jpegData)) {
+        throw runtime_error("Unable to encode the frame " + to_string(frameIndex) + ".");
+    }
+    jpegArchiveWriter.append(frameIndex, jpegData);
+}
+
+void VideoFrameWriterMultiJpegArchiveImpl::flush() {
+    finalized = true;
+    if (jpegArchiveWriter.isOpen()) {
+        jpegArchiveWriter.close();
+    }
+}
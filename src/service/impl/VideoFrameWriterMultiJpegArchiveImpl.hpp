@@ -0,0 +1,62 @@
+#ifndef SERVICE_VIDEO_FRAME_WRITER_MULTI_JPEG_ARCHIVE_IMPL
+#define SERVICE_VIDEO_FRAME_WRITER_MULTI_JPEG_ARCHIVE_IMPL
+
+#include <boost/filesystem.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../model/VideoProperties.hpp"
+#include "../../utils/BackgroundFileRemover.hpp"
+#include "../../utils/JpegArchive.hpp"
+#include "../../utils/logging.hpp"
+#include "../VideoFrameWriter.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoFrameWriter} that encodes each frame into a JPEG image, like
+     * {@link VideoFrameWriterMultiJpegImpl}, but appends all the images into a single
+     * {@link utils::JpegArchive} file instead of creating one file per frame.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoFrameWriterMultiJpegArchiveImpl : public VideoFrameWriter {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const boost::filesystem::path& inputVideoPath;
+            const int outputFrameWidth;
+            const int outputFrameHeight;
+
+            utils::BackgroundFileRemover backgroundFileRemover;
+            utils::JpegArchiveWriter jpegArchiveWriter;
+            bool finalized = false;
+
+        public:
+            VideoFrameWriterMultiJpegArchiveImpl(
+                const model::Configuration& configuration,
+                const boost::filesystem::path& inputVideoPath,
+                const model::VideoProperties& videoProperties) :
+                    configuration(configuration),
+                    inputVideoPath(inputVideoPath),
+                    outputFrameWidth(videoProperties.frameWidth + 2 * configuration.renderingVideoFrameMarginsInPixels),
+                    outputFrameHeight(videoProperties.frameHeight + 2 * configuration.renderingVideoFrameMarginsInPixels) {}
+
+            virtual ~VideoFrameWriterMultiJpegArchiveImpl();
+
+            virtual cv::Mat buildOutputFrame();
+
+            virtual void writeFrameAt(int frameIndex, cv::Mat& frame);
+
+            virtual void discardOutputFrame(cv::Mat& frame) {};
+
+            /**
+             * Write the offset table and the footer of the archive. No frame can be written after this call.
+             */
+            virtual void flush();
+
+            virtual void cancel() {};
+    };
+
+}
+
+#endif // SERVICE_VIDEO_FRAME_WRITER_MULTI_JPEG_ARCHIVE_IMPL
@@ -2,7 +2,6 @@
 #include "VideoFrameWriterMultiJpegImpl.hpp"
 
 using namespace service;
-using std::runtime_error;
 using std::string;
 using std::to_string;
 namespace fs = boost::filesystem;
@@ -18,11 +17,7 @@ void VideoFrameWriterMultiJpegImpl::writeFrameAt(int frameIndex, cv::Mat& frame)
         string outputFolderName = inputVideoPath.stem().string();
         outputFolderPath = fs::path(configuration.renderingOutputPath / outputFolderName);
 
-        if (fs::is_directory(outputFolderPath) || fs::exists(outputFolderPath)) {
-            if (!fs::remove_all(outputFolderPath)) {
-                throw runtime_error("Unable to delete the folder: " + outputFolderPath.string());
-            }
-        }
+        backgroundFileRemover.remove(outputFolderPath);
         fs::create_directories(outputFolderPath);
 
         folderInitialized = true;
@@ -4,6 +4,7 @@
 #include <boost/filesystem.hpp>
 #include "../../model/Configuration.hpp"
 #include "../../model/VideoProperties.hpp"
+#include "../../utils/BackgroundFileRemover.hpp"
 #include "../../utils/logging.hpp"
 #include "../VideoFrameWriter.hpp"
 
@@ -19,6 +20,7 @@ namespace service {
             const int outputFrameHeight;
 
             boost::filesystem::path outputFolderPath;
+            utils::BackgroundFileRemover backgroundFileRemover;
 
             bool folderInitialized = false;
 
@@ -37,6 +39,12 @@ namespace service {
             virtual cv::Mat buildOutputFrame();
 
             virtual void writeFrameAt(int frameIndex, cv::Mat& frame);
+
+            virtual void discardOutputFrame(cv::Mat& frame) {};
+
+            virtual void flush() {};
+
+            virtual void cancel() {};
     };
 
 }
@@ -0,0 +1,146 @@
+#include <stdexcept>
+#include "VideoFrameWriterReorderImpl.hpp"
+
+using namespace service;
+using std::lock_guard;
+using std::make_pair;
+using std::mutex;
+using std::runtime_error;
+using std::to_string;
+using std::unique_lock;
+namespace chrono = std::chrono;
+
+VideoFrameWriterReorderImpl::~VideoFrameWriterReorderImpl() {
+    if (!bufferedFramesByIndex.empty()) {
+        LOG_WARN(logger) << bufferedFramesByIndex.size() << " frames were never written because the frame "
+            << nextFrameIndex << " is missing.";
+    }
+    logStatistics();
+}
+
+cv::Mat VideoFrameWriterReorderImpl::buildOutputFrame() {
+    return wrappedVideoFrameWriter.buildOutputFrame();
+}
+
+void VideoFrameWriterReorderImpl::writeFrameAt(int frameIndex, cv::Mat& frame) {
+    unique_lock<mutex> lock(bufferMutex);
+
+    if (frameIndex < nextFrameIndex || bufferedFramesByIndex.count(frameIndex)) {
+        throw runtime_error("The frame " + to_string(frameIndex) + " has already been written.");
+    }
+
+    // Wait until the frame is inside the window
+    if (frameIndex >= nextFrameIndex + windowSize) {
+        auto stallStartTime = Clock::now();
+        windowMovedCondition.wait(lock, [this, frameIndex] {
+            return writingError || frameIndex < nextFrameIndex + windowSize;
+        });
+        totalCallerStallTimeMs +=
+            chrono::duration<double, std::milli>(Clock::now() - stallStartTime).count();
+    }
+    if (writingError) {
+        std::rethrow_exception(writingError);
+    }
+
+    bufferedFramesByIndex.emplace(frameIndex, make_pair(frame, Clock::now()));
+    nbBufferedFrames++;
+    if ((int) bufferedFramesByIndex.size() > maxNbBufferedFrames) {
+        maxNbBufferedFrames = bufferedFramesByIndex.size();
+    }
+
+    // Only one thread at a time gives frames to the wrapped writer, in order to keep the sequence
+    if (!emittingFrames) {
+        emitSequentialFrames(lock);
+    }
+}
+
+void VideoFrameWriterReorderImpl::discardOutputFrame(cv::Mat& frame) {
+    {
+        // The buffered frames are given to the wrapped writer or discarded by cancel()
+        lock_guard<mutex> lock(bufferMutex);
+        for (const auto& bufferedFrame : bufferedFramesByIndex) {
+            if (bufferedFrame.second.first.data == frame.data) {
+                return;
+            }
+        }
+    }
+    wrappedVideoFrameWriter.discardOutputFrame(frame);
+}
+
+void VideoFrameWriterReorderImpl::flush() {
+    {
+        unique_lock<mutex> lock(bufferMutex);
+        windowMovedCondition.wait(lock, [this] {
+            return writingError || !emittingFrames;
+        });
+        if (writingError) {
+            std::rethrow_exception(writingError);
+        }
+        if (!bufferedFramesByIndex.empty()) {
+            throw runtime_error("Unable to write the buffered frames: the frame "
+                + to_string(nextFrameIndex) + " is missing.");
+        }
+    }
+
+    logStatistics();
+    wrappedVideoFrameWriter.flush();
+}
+
+void VideoFrameWriterReorderImpl::cancel() {
+    std::map<int, std::pair<cv::Mat, Clock::time_point>> droppedFramesByIndex;
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        if (!writingError) {
+            writingError = std::make_exception_ptr(runtime_error("The video writing was cancelled."));
+        }
+        droppedFramesByIndex.swap(bufferedFramesByIndex);
+    }
+    windowMovedCondition.notify_all();
+
+    // The buffered frames will never be written
+    for (auto& droppedFrame : droppedFramesByIndex) {
+        wrappedVideoFrameWriter.discardOutputFrame(droppedFrame.second.first);
+    }
+    wrappedVideoFrameWriter.cancel();
+}
+
+void VideoFrameWriterReorderImpl::emitSequentialFrames(unique_lock<mutex>& lock) {
+    emittingFrames = true;
+
+    auto frameIterator = bufferedFramesByIndex.find(nextFrameIndex);
+    while (frameIterator != bufferedFramesByIndex.end()) {
+        int frameIndex = frameIterator->first;
+        cv::Mat frame = frameIterator->second.first;
+        totalBufferedTimeMs +=
+            chrono::duration<double, std::milli>(Clock::now() - frameIterator->second.second).count();
+        bufferedFramesByIndex.erase(frameIterator);
+        lock.unlock();
+
+        try {
+            wrappedVideoFrameWriter.writeFrameAt(frameIndex, frame);
+        } catch (...) {
+            lock.lock();
+            writingError = std::current_exception();
+            emittingFrames = false;
+            windowMovedCondition.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        nextFrameIndex = frameIndex + 1;
+        windowMovedCondition.notify_all();
+        frameIterator = bufferedFramesByIndex.find(nextFrameIndex);
+    }
+
+    emittingFrames = false;
+    windowMovedCondition.notify_all();
+}
+
+void VideoFrameWriterReorderImpl::logStatistics() {
+    lock_guard<mutex> lock(bufferMutex);
+    double avgBufferedTimeMs = nbBufferedFrames == 0 ? 0.0 : totalBufferedTimeMs / nbBufferedFrames;
+    LOG_INFO(logger) << "Reorder buffer statistics: currently buffered frames = " << bufferedFramesByIndex.size()
+        << ", max buffered frames = " << maxNbBufferedFrames << "/" << windowSize
+        << ", average time in buffer = " << avgBufferedTimeMs << " ms"
+        << ", total time callers waited for the window = " << totalCallerStallTimeMs << " ms.";
+}
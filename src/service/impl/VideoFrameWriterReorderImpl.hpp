@@ -0,0 +1,80 @@
+#ifndef SERVICE_VIDEO_FRAME_WRITER_REORDER_IMPL
+#define SERVICE_VIDEO_FRAME_WRITER_REORDER_IMPL
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <utility>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../VideoFrameWriter.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoFrameWriter} that wraps another {@link VideoFrameWriter}
+     * in order to accept frames in any order, as long as they are within a window of
+     * {@link model::Configuration#renderingReorderWindowSize} frames after the next frame to write.
+     *
+     * Frames are buffered until all the previous ones have been received, then they are given to
+     * the wrapped writer in sequence. A caller with a frame outside of the window is blocked until
+     * the window moves forward. This class is thread-safe.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoFrameWriterReorderImpl : public VideoFrameWriter {
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            VideoFrameWriter& wrappedVideoFrameWriter;
+            const int windowSize;
+
+            std::mutex bufferMutex;
+            std::condition_variable windowMovedCondition;
+            std::map<int, std::pair<cv::Mat, Clock::time_point>> bufferedFramesByIndex;
+            int nextFrameIndex = 0;
+            bool emittingFrames = false;
+            std::exception_ptr writingError;
+
+            int maxNbBufferedFrames = 0;
+            long nbBufferedFrames = 0;
+            double totalBufferedTimeMs = 0;
+            double totalCallerStallTimeMs = 0;
+
+        public:
+            VideoFrameWriterReorderImpl(
+                const model::Configuration& configuration,
+                VideoFrameWriter& wrappedVideoFrameWriter) :
+                    wrappedVideoFrameWriter(wrappedVideoFrameWriter),
+                    windowSize(configuration.renderingReorderWindowSize) {}
+
+            virtual ~VideoFrameWriterReorderImpl();
+
+            virtual cv::Mat buildOutputFrame();
+
+            virtual void writeFrameAt(int frameIndex, cv::Mat& frame);
+
+            virtual void discardOutputFrame(cv::Mat& frame);
+
+            virtual void flush();
+
+            virtual void cancel();
+
+        private:
+            /**
+             * Give the buffered frames to the wrapped writer until a frame is missing.
+             * Must be called with a lock on the bufferMutex.
+             */
+            void emitSequentialFrames(std::unique_lock<std::mutex>& lock);
+
+            void logStatistics();
+    };
+
+}
+
+#endif // SERVICE_VIDEO_FRAME_WRITER_REORDER_IMPL
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "VideoProcessorCalibrateDetectorImpl.hpp"
+#include "ObjectDetectorOnnxImpl.hpp"
+#include "ObjectDetectorOpenCvDnnImpl.hpp"
+#include "../../utils/AtomicFileWriter.hpp"
+#include "../../utils/DnnBackendHelper.hpp"
+
+using namespace model;
+using namespace service;
+using namespace utils;
+using std::max;
+using std::min;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+void VideoProcessorCalibrateDetectorImpl::processVideo() {
+    if (configuration.objectDetectionImplementation == "darknet") {
+        throw std::runtime_error("--calibrate-detector does not support the \"darknet\" implementation.");
+    }
+
+    // The first batch is not measured, so at least one more frame is needed
+    if (endFrameIndex - firstFrameIndex < 2) {
+        throw std::runtime_error("--calibrate-detector needs at least 2 frames between --start-frame and --end-frame.");
+    }
+
+    // Read the sample frames
+    int nbFrames = min(max(2, configuration.objectDetectionCalibrationNbFrames), endFrameIndex - firstFrameIndex);
+    vector<cv::Mat> frames;
+    for (int frameIndex = firstFrameIndex; frameIndex < firstFrameIndex + nbFrames; frameIndex++) {
+        frames.push_back(videoFrameReader.readFrameAt(frameIndex).clone());
+    }
+
+    // Numbers of threads to try: powers of 2 and the number of CPU cores
+    int nbCores = max(1, (int) std::thread::hardware_concurrency());
+    vector<int> nbThreadsCandidates;
+    for (int nbThreads = 1; nbThreads < nbCores; nbThreads *= 2) {
+        nbThreadsCandidates.push_back(nbThreads);
+    }
+    nbThreadsCandidates.push_back(nbCores);
+
+    // Measure the detection time with each valid combination
+    stringstream report;
+    double bestDurationMs = std::numeric_limits<double>::max();
+    string bestBackendName;
+    string bestTargetName;
+    int bestNbThreads = 0;
+    for (const auto& backendAndTarget : cv::dnn::getAvailableBackends()) {
+        string backendName = DnnBackendHelper::backendToString(backendAndTarget.first);
+        string targetName = DnnBackendHelper::targetToString(backendAndTarget.second);
+
+        for (int nbThreads : nbThreadsCandidates) {
+            LOG_INFO(logger) << "Calibration: backend = " << backendName << ", target = " << targetName
+                << ", " << nbThreads << " thread(s)...";
+            double durationMs;
+            try {
+                durationMs = measureDetectionTime(backendName, targetName, nbThreads, frames);
+            } catch (const std::exception& e) {
+                LOG_WARN(logger) << "Calibration: backend = " << backendName << ", target = " << targetName
+                    << " is not usable: " << e.what();
+                report << "# " << backendName << " / " << targetName << ": not usable\n";
+                break;
+            }
+
+            LOG_INFO(logger) << "Calibration: " << durationMs << " ms per frame.";
+            report << "# " << backendName << " / " << targetName << " / " << nbThreads << " thread(s): "
+                << durationMs << " ms per frame\n";
+            if (durationMs < bestDurationMs) {
+                bestDurationMs = durationMs;
+                bestBackendName = backendName;
+                bestTargetName = targetName;
+                bestNbThreads = nbThreads;
+            }
+        }
+    }
+    if (bestNbThreads == 0) {
+        throw std::runtime_error("No OpenCV DNN backend can run the neural network.");
+    }
+
+    // Write the recommendation
+    stringstream calibration;
+    calibration << "# Fastest settings of the \"" << configuration.objectDetectionImplementation
+        << "\" implementation on this machine, measured on "
+        << nbFrames << " frames with batchSize=" << max(1, configuration.objectDetectionBatchSize) << ".\n"
+        << "# Copy them into the [objectDetection] section of the configuration file.\n"
+        << report.str()
+        << "[objectDetection]\n"
+        << "dnnBackend=" << bestBackendName << "\n"
+        << "dnnTarget=" << bestTargetName << "\n"
+        << "nbThreadsPerReplica=" << bestNbThreads << "\n";
+    AtomicFileWriter::write(calibrationPath, calibration.str());
+
+    LOG_INFO(logger) << "Calibration done: backend = " << bestBackendName << ", target = " << bestTargetName
+        << ", " << bestNbThreads << " thread(s) (" << bestDurationMs << " ms per frame). Recommendation written to "
+        << calibrationPath.string() << ".";
+}
+
+double VideoProcessorCalibrateDetectorImpl::measureDetectionTime(
+    const string& backendName,
+    const string& targetName,
+    int nbThreads,
+    const vector<cv::Mat>& frames) const {
+
+    Configuration candidateConfiguration = configuration;
+    candidateConfiguration.objectDetectionDnnBackend = backendName;
+    candidateConfiguration.objectDetectionDnnTarget = targetName;
+    candidateConfiguration.objectDetectionNbReplicas = 1;
+    candidateConfiguration.objectDetectionNbThreadsPerReplica = nbThreads;
+    std::unique_ptr<ObjectDetector> pObjectDetector;
+    if (configuration.objectDetectionImplementation == "onnx") {
+        pObjectDetector.reset(new ObjectDetectorOnnxImpl(
+            candidateConfiguration, candidateConfiguration.yoloModelOnnxPath, false));
+    } else if (configuration.objectDetectionImplementation == "onnx-int8") {
+        pObjectDetector.reset(new ObjectDetectorOnnxImpl(
+            candidateConfiguration, candidateConfiguration.yoloModelOnnxInt8Path, true));
+    } else {
+        pObjectDetector.reset(new ObjectDetectorOpenCvDnnImpl(candidateConfiguration));
+    }
+    ObjectDetector& objectDetector = *pObjectDetector;
+
+    // Note: the number of OpenCV threads is global, it is owned by the calibration in this mode
+    cv::setNumThreads(nbThreads);
+
+    // The first batch loads the neural network and initializes the backend, so it is not measured
+    int batchSize = max(1, configuration.objectDetectionBatchSize);
+    int nbWarmUpFrames = min(batchSize, (int) frames.size() - 1);
+    objectDetector.detectObjectsAt(
+        firstFrameIndex, vector<cv::Mat>(frames.begin(), frames.begin() + nbWarmUpFrames));
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int frameOffset = nbWarmUpFrames; frameOffset < (int) frames.size(); frameOffset += batchSize) {
+        int nbBatchFrames = min(batchSize, (int) frames.size() - frameOffset);
+        objectDetector.detectObjectsAt(
+            firstFrameIndex + frameOffset,
+            vector<cv::Mat>(frames.begin() + frameOffset, frames.begin() + frameOffset + nbBatchFrames));
+    }
+    double durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return durationMs / (frames.size() - nbWarmUpFrames);
+}
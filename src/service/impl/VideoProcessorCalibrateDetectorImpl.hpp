@@ -0,0 +1,65 @@
+#ifndef SERVICE_VIDEO_PROCESSOR_CALIBRATE_DETECTOR_IMPL
+#define SERVICE_VIDEO_PROCESSOR_CALIBRATE_DETECTOR_IMPL
+
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <boost/filesystem.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../VideoFrameReader.hpp"
+#include "../VideoProcessor.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoProcessor} that finds the fastest settings of the "opencvdnn"
+     * {@link ObjectDetector} on this machine.
+     *
+     * Objects are detected in objectDetection.calibrationNbFrames frames (from firstFrameIndex) with each
+     * combination of backend, target and number of threads supported by OpenCV. The fastest combination is
+     * written into calibrationPath as a recommendation (the configuration file is not modified).
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoProcessorCalibrateDetectorImpl : public VideoProcessor {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const int firstFrameIndex;
+            const int endFrameIndex;
+            VideoFrameReader& videoFrameReader;
+            const boost::filesystem::path calibrationPath;
+
+        public:
+            VideoProcessorCalibrateDetectorImpl(
+                const model::Configuration& configuration,
+                int firstFrameIndex,
+                int endFrameIndex,
+                VideoFrameReader& videoFrameReader,
+                const boost::filesystem::path& calibrationPath) :
+                    configuration(configuration),
+                    firstFrameIndex(firstFrameIndex),
+                    endFrameIndex(endFrameIndex),
+                    videoFrameReader(videoFrameReader),
+                    calibrationPath(calibrationPath) {}
+
+            virtual ~VideoProcessorCalibrateDetectorImpl() {}
+
+            virtual void processVideo();
+
+        private:
+            /**
+             * @return Average detection time per frame in milliseconds.
+             */
+            double measureDetectionTime(
+                const std::string& backendName,
+                const std::string& targetName,
+                int nbThreads,
+                const std::vector<cv::Mat>& frames) const;
+    };
+
+}
+
+#endif // SERVICE_VIDEO_PROCESSOR_CALIBRATE_DETECTOR_IMPL
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include "VideoProcessorCompareDetectorsImpl.hpp"
+#include "../../utils/AtomicFileWriter.hpp"
+
+using namespace model;
+using namespace service;
+using namespace utils;
+using std::max;
+using std::min;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+namespace {
+
+    // Minimum intersection over union for a compared detection to match a reference one
+    const double MIN_MATCHING_IOU = 0.5;
+
+    class ClassAgreement {
+        public:
+            int nbReferenceObjects = 0;
+            int nbComparedObjects = 0;
+            int nbMatchedObjects = 0;
+            double iouSum = 0;
+    };
+
+    double computeIntersectionOverUnion(const Rectangle& rect1, const Rectangle& rect2) {
+        double intersectionArea = Rectangle::getIntersection(rect1, rect2).area();
+        double unionArea = rect1.area() + rect2.area() - intersectionArea;
+        return unionArea > 0 ? intersectionArea / unionArea : 0;
+    }
+
+    /**
+     * Match each reference object (most confident first) with the unmatched compared object of the same
+     * class that overlaps it the most.
+     */
+    void matchObjects(
+        vector<DetectedObject> referenceObjects,
+        const vector<DetectedObject>& comparedObjects,
+        std::map<DetectedObjectType, ClassAgreement>& agreementsByType) {
+
+        std::sort(referenceObjects.begin(), referenceObjects.end(), [](const auto& o1, const auto& o2) {
+            return o1.confidence > o2.confidence;
+        });
+        vector<bool> isComparedObjectMatched(comparedObjects.size(), false);
+
+        for (const DetectedObject& referenceObject : referenceObjects) {
+            agreementsByType[referenceObject.objectType].nbReferenceObjects++;
+
+            int bestIndex = -1;
+            double bestIou = MIN_MATCHING_IOU;
+            for (size_t i = 0; i < comparedObjects.size(); i++) {
+                if (isComparedObjectMatched[i] || comparedObjects[i].objectType != referenceObject.objectType) {
+                    continue;
+                }
+                double iou = computeIntersectionOverUnion(referenceObject, comparedObjects[i]);
+                if (iou >= bestIou) {
+                    bestIou = iou;
+                    bestIndex = i;
+                }
+            }
+            if (bestIndex >= 0) {
+                isComparedObjectMatched[bestIndex] = true;
+                agreementsByType[referenceObject.objectType].nbMatchedObjects++;
+                agreementsByType[referenceObject.objectType].iouSum += bestIou;
+            }
+        }
+        for (const DetectedObject& comparedObject : comparedObjects) {
+            agreementsByType[comparedObject.objectType].nbComparedObjects++;
+        }
+    }
+
+    string describeLatencies(vector<double> latenciesMs) {
+        std::sort(latenciesMs.begin(), latenciesMs.end());
+        double sumMs = 0;
+        for (double latencyMs : latenciesMs) {
+            sumMs += latencyMs;
+        }
+        int nbLatencies = latenciesMs.size();
+        stringstream description;
+        description << "mean " << sumMs / nbLatencies << " ms"
+            << ", median " << latenciesMs[nbLatencies / 2] << " ms"
+            << ", p95 " << latenciesMs[min(nbLatencies - 1, (int) (nbLatencies * 0.95))] << " ms";
+        return description.str();
+    }
+
+    double computeMean(const vector<double>& values) {
+        double sum = 0;
+        for (double value : values) {
+            sum += value;
+        }
+        return sum / values.size();
+    }
+
+    string formatRatio(int numerator, int denominator) {
+        if (denominator == 0) {
+            return "-";
+        }
+        stringstream ratio;
+        ratio << std::fixed << std::setprecision(1) << (100.0 * numerator / denominator) << "%";
+        return ratio.str();
+    }
+
+}
+
+void VideoProcessorCompareDetectorsImpl::processVideo() {
+    int nbFrames = min(max(1, configuration.objectDetectionComparisonNbFrames), endFrameIndex - firstFrameIndex);
+    if (nbFrames <= 0) {
+        throw std::runtime_error("No frame to compare the detectors.");
+    }
+
+    // Load the neural networks before measuring anything
+    LOG_INFO(logger) << "Comparison: load the reference and compared detectors...";
+    referenceObjectDetector.warmUp();
+    comparedObjectDetector.warmUp();
+
+    vector<double> referenceLatenciesMs;
+    vector<double> comparedLatenciesMs;
+    std::map<DetectedObjectType, ClassAgreement> agreementsByType;
+    for (int frameIndex = firstFrameIndex; frameIndex < firstFrameIndex + nbFrames; frameIndex++) {
+        cv::Mat frame = videoFrameReader.readFrameAt(frameIndex);
+        vector<DetectedObject> referenceObjects = detectObjectsAt(
+            referenceObjectDetector, frameIndex, frame, referenceLatenciesMs);
+        vector<DetectedObject> comparedObjects = detectObjectsAt(
+            comparedObjectDetector, frameIndex, frame, comparedLatenciesMs);
+        matchObjects(referenceObjects, comparedObjects, agreementsByType);
+
+        LOG_INFO(logger) << "Comparison of the frame " << frameIndex << ": "
+            << referenceObjects.size() << " reference objects in " << referenceLatenciesMs.back() << " ms, "
+            << comparedObjects.size() << " compared objects in " << comparedLatenciesMs.back() << " ms.";
+    }
+
+    // Write the report
+    stringstream report;
+    report << "Comparison of the \"" << configuration.objectDetectionImplementation
+        << "\" implementation with the reference \"opencvdnn\" implementation on " << nbFrames << " frames.\n\n"
+        << "Latency per frame:\n"
+        << "  reference: " << describeLatencies(referenceLatenciesMs) << "\n"
+        << "  compared:  " << describeLatencies(comparedLatenciesMs) << "\n"
+        << "  speedup:   " << computeMean(referenceLatenciesMs) / computeMean(comparedLatenciesMs) << "x\n\n"
+        << "Detection agreement (same class and IoU >= " << MIN_MATCHING_IOU << "):\n";
+
+    ClassAgreement totalAgreement;
+    for (DetectedObjectType objectType : DetectedObjectTypeHelper::enumerate()) {
+        const ClassAgreement& agreement = agreementsByType[objectType];
+        report << "  " << std::left << std::setw(10) << DetectedObjectTypeHelper::enumToString(objectType)
+            << " reference: " << agreement.nbReferenceObjects
+            << ", compared: " << agreement.nbComparedObjects
+            << ", matched: " << agreement.nbMatchedObjects
+            << " (recall " << formatRatio(agreement.nbMatchedObjects, agreement.nbReferenceObjects)
+            << ", precision " << formatRatio(agreement.nbMatchedObjects, agreement.nbComparedObjects)
+            << ", mean IoU " << (agreement.nbMatchedObjects > 0 ? agreement.iouSum / agreement.nbMatchedObjects : 0)
+            << ")\n";
+        totalAgreement.nbReferenceObjects += agreement.nbReferenceObjects;
+        totalAgreement.nbComparedObjects += agreement.nbComparedObjects;
+        totalAgreement.nbMatchedObjects += agreement.nbMatchedObjects;
+    }
+    report << "  " << std::left << std::setw(10) << "ALL"
+        << " reference: " << totalAgreement.nbReferenceObjects
+        << ", compared: " << totalAgreement.nbComparedObjects
+        << ", matched: " << totalAgreement.nbMatchedObjects
+        << " (recall " << formatRatio(totalAgreement.nbMatchedObjects, totalAgreement.nbReferenceObjects)
+        << ", precision " << formatRatio(totalAgreement.nbMatchedObjects, totalAgreement.nbComparedObjects)
+        << ")\n";
+
+    AtomicFileWriter::write(reportPath, report.str());
+    LOG_INFO(logger) << "Detector comparison written into " << reportPath.string() << ":\n" << report.str();
+}
+
+vector<DetectedObject> VideoProcessorCompareDetectorsImpl::detectObjectsAt(
+    ObjectDetector& objectDetector,
+    int frameIndex,
+    const cv::Mat& frame,
+    vector<double>& latenciesMs) const {
+
+    auto startTime = std::chrono::steady_clock::now();
+    vector<DetectedObject> detectedObjects = objectDetector.detectObjectsAt(frameIndex, frame);
+    latenciesMs.push_back(
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+    return detectedObjects;
+}
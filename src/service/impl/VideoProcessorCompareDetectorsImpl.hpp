@@ -0,0 +1,75 @@
+#ifndef SERVICE_VIDEO_PROCESSOR_COMPARE_DETECTORS_IMPL
+#define SERVICE_VIDEO_PROCESSOR_COMPARE_DETECTORS_IMPL
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <boost/filesystem.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../model/detection/DetectedObject.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+#include "../VideoFrameReader.hpp"
+#include "../VideoProcessor.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoProcessor} that compares the configured {@link ObjectDetector}
+     * (e.g. an INT8 model) with the reference FP32 "opencvdnn" implementation.
+     *
+     * Both detectors process the same objectDetection.comparisonNbFrames frames (from firstFrameIndex) one
+     * by one. The report contains the latency per frame of each detector, and for each class of objects, how
+     * many detections of the reference detector are also found by the compared one (same class and
+     * intersection over union of at least 0.5). It is logged and written into reportPath.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoProcessorCompareDetectorsImpl : public VideoProcessor {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const int firstFrameIndex;
+            const int endFrameIndex;
+            VideoFrameReader& videoFrameReader;
+            ObjectDetector& referenceObjectDetector;
+            ObjectDetector& comparedObjectDetector;
+            const boost::filesystem::path reportPath;
+
+        public:
+            VideoProcessorCompareDetectorsImpl(
+                const model::Configuration& configuration,
+                int firstFrameIndex,
+                int endFrameIndex,
+                VideoFrameReader& videoFrameReader,
+                ObjectDetector& referenceObjectDetector,
+                ObjectDetector& comparedObjectDetector,
+                const boost::filesystem::path& reportPath) :
+                    configuration(configuration),
+                    firstFrameIndex(firstFrameIndex),
+                    endFrameIndex(endFrameIndex),
+                    videoFrameReader(videoFrameReader),
+                    referenceObjectDetector(referenceObjectDetector),
+                    comparedObjectDetector(comparedObjectDetector),
+                    reportPath(reportPath) {}
+
+            virtual ~VideoProcessorCompareDetectorsImpl() {}
+
+            virtual void processVideo();
+
+        private:
+            /**
+             * Detect the objects of the given frame and measure the time it takes.
+             *
+             * @param latenciesMs Where the detection time in milliseconds is added.
+             */
+            std::vector<model::DetectedObject> detectObjectsAt(
+                ObjectDetector& objectDetector,
+                int frameIndex,
+                const cv::Mat& frame,
+                std::vector<double>& latenciesMs) const;
+    };
+
+}
+
+#endif // SERVICE_VIDEO_PROCESSOR_COMPARE_DETECTORS_IMPL
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <opencv2/opencv.hpp>
+#include "VideoProcessorDetectOnlyImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::lock_guard;
+using std::max;
+using std::min;
+using std::mutex;
+using std::thread;
+using std::vector;
+
+void VideoProcessorDetectOnlyImpl::processVideo() {
+    int nbSegments = segmentObjectDetectors.size();
+    int nbFrames = endFrameIndex - firstFrameIndex;
+    int nbFramesPerSegment = (nbFrames + nbSegments - 1) / nbSegments;
+
+    // Share the CPU cores among the neural networks
+    int nbThreadsPerSegment = max(1, (int) thread::hardware_concurrency() / nbSegments);
+    cv::setNumThreads(nbThreadsPerSegment);
+
+    LOG_INFO(logger) << "Detect objects in " << nbSegments << " segments of " << nbFramesPerSegment
+        << " frames (" << nbThreadsPerSegment << " thread(s) per segment)...";
+    auto startTime = std::chrono::steady_clock::now();
+
+    vector<thread> segmentThreads;
+    for (int segmentIndex = 0; segmentIndex < nbSegments; segmentIndex++) {
+        int segmentFirstFrameIndex = firstFrameIndex + segmentIndex * nbFramesPerSegment;
+        int segmentEndFrameIndex = min(endFrameIndex, segmentFirstFrameIndex + nbFramesPerSegment);
+        VideoFrameReader& videoFrameReader = *segmentVideoFrameReaders[segmentIndex];
+        ObjectDetector& objectDetector = *segmentObjectDetectors[segmentIndex];
+
+        segmentThreads.push_back(thread([=, &videoFrameReader, &objectDetector] {
+            try {
+                detectObjectsInSegment(
+                    segmentIndex, videoFrameReader, objectDetector, segmentFirstFrameIndex, segmentEndFrameIndex);
+            } catch (...) {
+                LOG_ERROR(logger) << "Unable to detect objects in the segment " << segmentIndex << ".";
+                stopped = true;
+                lock_guard<mutex> lock(segmentErrorMutex);
+                if (!segmentError) {
+                    segmentError = std::current_exception();
+                }
+            }
+        }));
+    }
+    for (thread& segmentThread : segmentThreads) {
+        segmentThread.join();
+    }
+
+    if (segmentError) {
+        std::rethrow_exception(segmentError);
+    }
+
+    double durationSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    LOG_INFO(logger) << "Objects detected in " << nbFrames << " frames in " << durationSec
+        << " s (" << (nbFrames / max(durationSec, 0.001)) << " frames/s).";
+}
+
+void VideoProcessorDetectOnlyImpl::detectObjectsInSegment(
+    int segmentIndex,
+    VideoFrameReader& videoFrameReader,
+    ObjectDetector& objectDetector,
+    int segmentFirstFrameIndex,
+    int segmentEndFrameIndex) {
+
+    int batchSize = max(1, configuration.objectDetectionBatchSize);
+    for (int frameIndex = segmentFirstFrameIndex; frameIndex < segmentEndFrameIndex && !stopped;
+        frameIndex += batchSize) {
+        int nbFrames = min(batchSize, segmentEndFrameIndex - frameIndex);
+        vector<cv::Mat> frames;
+        for (int i = 0; i < nbFrames; i++) {
+            frames.push_back(videoFrameReader.readFrameAt(frameIndex + i));
+        }
+        objectDetector.detectObjectsAt(frameIndex, frames);
+
+        LOG_INFO(logger) << "Segment " << segmentIndex << ": frames " << segmentFirstFrameIndex << "-"
+            << (frameIndex + nbFrames - 1) << "/" << (segmentEndFrameIndex - 1) << " processed.";
+    }
+}
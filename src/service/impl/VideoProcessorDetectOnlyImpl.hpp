@@ -0,0 +1,69 @@
+#ifndef SERVICE_VIDEO_PROCESSOR_DETECT_ONLY_IMPL
+#define SERVICE_VIDEO_PROCESSOR_DETECT_ONLY_IMPL
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+#include "../../model/Configuration.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+#include "../VideoFrameReader.hpp"
+#include "../VideoProcessor.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoProcessor} that only detects objects, in order to fill the cache
+     * of {@link ObjectDetectorCacheImpl}. Unlike tracking, detection does not depend on the previous
+     * frames, so the video is split into segments of consecutive frames processed in parallel.
+     *
+     * Only the frames between firstFrameIndex (inclusive) and endFrameIndex (exclusive) are processed.
+     * Each segment has its own {@link VideoFrameReader} and {@link ObjectDetector} (with its own neural
+     * network and cache).
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoProcessorDetectOnlyImpl : public VideoProcessor {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const int firstFrameIndex;
+            const int endFrameIndex;
+            const std::vector<VideoFrameReader*> segmentVideoFrameReaders;
+            const std::vector<ObjectDetector*> segmentObjectDetectors;
+
+            std::atomic<bool> stopped{false};
+            std::mutex segmentErrorMutex;
+            std::exception_ptr segmentError;
+
+        public:
+            VideoProcessorDetectOnlyImpl(
+                const model::Configuration& configuration,
+                int firstFrameIndex,
+                int endFrameIndex,
+                const std::vector<VideoFrameReader*>& segmentVideoFrameReaders,
+                const std::vector<ObjectDetector*>& segmentObjectDetectors) :
+                    configuration(configuration),
+                    firstFrameIndex(firstFrameIndex),
+                    endFrameIndex(endFrameIndex),
+                    segmentVideoFrameReaders(segmentVideoFrameReaders),
+                    segmentObjectDetectors(segmentObjectDetectors) {}
+
+            virtual ~VideoProcessorDetectOnlyImpl() {}
+
+            virtual void processVideo();
+
+        private:
+            void detectObjectsInSegment(
+                int segmentIndex,
+                VideoFrameReader& videoFrameReader,
+                ObjectDetector& objectDetector,
+                int segmentFirstFrameIndex,
+                int segmentEndFrameIndex);
+    };
+
+}
+
+#endif // SERVICE_VIDEO_PROCESSOR_DETECT_ONLY_IMPL
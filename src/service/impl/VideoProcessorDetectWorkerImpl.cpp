@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "VideoProcessorDetectWorkerImpl.hpp"
+
+using namespace model;
+using namespace service;
+using namespace utils;
+using std::max;
+using std::min;
+using std::vector;
+
+void VideoProcessorDetectWorkerImpl::processVideo() {
+    while (true) {
+        bool allRangesDone = true;
+        bool rangeAcquired = false;
+
+        for (const FrameRangeLeases::FrameRange& frameRange : frameRangeLeases.getFrameRanges()) {
+            FrameRangeLeases::RangeStatus status = frameRangeLeases.getStatus(frameRange);
+            if (status == FrameRangeLeases::RangeStatus::DONE) {
+                continue;
+            }
+            allRangesDone = false;
+
+            if (status != FrameRangeLeases::RangeStatus::PENDING || !frameRangeLeases.tryAcquire(frameRange)) {
+                continue;
+            }
+            rangeAcquired = true;
+
+            bool leaseKept;
+            try {
+                leaseKept = detectObjectsInRange(frameRange);
+            } catch (...) {
+                frameRangeLeases.release(frameRange);
+                throw;
+            }
+            if (!leaseKept) {
+                // The lease was considered stale and the range may now be processed by another worker
+                LOG_WARN(logger) << "The lease of the frames " << frameRange.firstFrameIndex << "-"
+                    << (frameRange.endFrameIndex - 1) << " was lost, abandon them.";
+                continue;
+            }
+            frameRangeLeases.complete(frameRange);
+
+            LOG_INFO(logger) << "Frames " << frameRange.firstFrameIndex << "-" << (frameRange.endFrameIndex - 1)
+                << " done (progress: " << frameRangeLeases.describeProgress() << ").";
+        }
+
+        if (allRangesDone) {
+            break;
+        }
+
+        // The remaining ranges are leased by other processes: wait in case some of them are released
+        if (!rangeAcquired) {
+            LOG_INFO(logger) << "Wait for the ranges leased by other workers (progress: "
+                << frameRangeLeases.describeProgress() << ")...";
+            int waitTimeInSeconds = max(1, frameRangeLeases.getLeaseTimeoutInSeconds() / 4);
+            std::this_thread::sleep_for(std::chrono::seconds(waitTimeInSeconds));
+        }
+    }
+
+    LOG_INFO(logger) << "All the frame ranges are done.";
+}
+
+bool VideoProcessorDetectWorkerImpl::detectObjectsInRange(const FrameRangeLeases::FrameRange& frameRange) {
+    int batchSize = max(1, configuration.objectDetectionBatchSize);
+    for (int frameIndex = frameRange.firstFrameIndex; frameIndex < frameRange.endFrameIndex; frameIndex += batchSize) {
+        int nbFrames = min(batchSize, frameRange.endFrameIndex - frameIndex);
+        vector<cv::Mat> frames;
+        for (int i = 0; i < nbFrames; i++) {
+            frames.push_back(videoFrameReader.readFrameAt(frameIndex + i));
+        }
+        objectDetector.detectObjectsAt(frameIndex, frames);
+        if (!frameRangeLeases.renew(frameRange)) {
+            return false;
+        }
+    }
+    return true;
+}
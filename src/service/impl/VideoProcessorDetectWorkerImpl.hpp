@@ -0,0 +1,53 @@
+#ifndef SERVICE_VIDEO_PROCESSOR_DETECT_WORKER_IMPL
+#define SERVICE_VIDEO_PROCESSOR_DETECT_WORKER_IMPL
+
+#include "../../model/Configuration.hpp"
+#include "../../utils/FrameRangeLeases.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+#include "../VideoFrameReader.hpp"
+#include "../VideoProcessor.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoProcessor} that only detects objects, in order to fill the cache
+     * of {@link ObjectDetectorCacheImpl} together with other processes of the same kind. The processes
+     * claim ranges of frames through {@link utils::FrameRangeLeases}, and stop when all the ranges are done.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoProcessorDetectWorkerImpl : public VideoProcessor {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            VideoFrameReader& videoFrameReader;
+            ObjectDetector& objectDetector;
+            const utils::FrameRangeLeases& frameRangeLeases;
+
+        public:
+            VideoProcessorDetectWorkerImpl(
+                const model::Configuration& configuration,
+                VideoFrameReader& videoFrameReader,
+                ObjectDetector& objectDetector,
+                const utils::FrameRangeLeases& frameRangeLeases) :
+                    configuration(configuration),
+                    videoFrameReader(videoFrameReader),
+                    objectDetector(objectDetector),
+                    frameRangeLeases(frameRangeLeases) {}
+
+            virtual ~VideoProcessorDetectWorkerImpl() {}
+
+            virtual void processVideo();
+
+        private:
+            /**
+             * @return false if the lease of the range was lost (the range must then be abandoned).
+             */
+            bool detectObjectsInRange(const utils::FrameRangeLeases::FrameRange& frameRange);
+    };
+
+}
+
+#endif // SERVICE_VIDEO_PROCESSOR_DETECT_WORKER_IMPL
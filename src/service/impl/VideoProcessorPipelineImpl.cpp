@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include "VideoProcessorPipelineImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::exception_ptr;
+using std::function;
+using std::lock_guard;
+using std::mutex;
+using std::string;
+using std::stringstream;
+using std::thread;
+using std::vector;
+
+static const vector<string> queueNames = { "decoded", "detected", "tracked", "painted" };
+
+void VideoProcessorPipelineImpl::processVideo() {
+    int queueCapacity = configuration.processingPipelineQueueCapacity;
+    int nbPaintingThreads = std::max(1, configuration.processingPipelineNbPaintingThreads);
+    LOG_INFO(logger) << "Start the processing pipeline (queue capacity = " << queueCapacity
+        << ", painting threads = " << nbPaintingThreads << ")...";
+
+    PipelineQueue decodedQueue(queueCapacity);
+    PipelineQueue detectedQueue(queueCapacity);
+    PipelineQueue trackedQueue(queueCapacity);
+    PipelineQueue paintedQueue(queueCapacity);
+    vector<PipelineQueue*> queues = { &decodedQueue, &detectedQueue, &trackedQueue, &paintedQueue };
+
+    thread decodingThread([&] {
+        runStage("decoding", queues, [&] { runDecodingStage(decodedQueue); });
+    });
+    thread detectionThread([&] {
+        runStage("detection", queues, [&] { runDetectionStage(decodedQueue, detectedQueue); });
+    });
+    thread trackingThread([&] {
+        runStage("tracking", queues, [&] { runTrackingStage(detectedQueue, trackedQueue); });
+    });
+
+    // With several painting threads, the frames are written by the painting threads themselves: a
+    // single encoding thread could block on a frame too far in the future while the missing one
+    // is stuck in a full queue.
+    bool writeFramesWhenPainted = nbPaintingThreads > 1;
+    nbRunningPaintingThreads = nbPaintingThreads;
+    vector<thread> paintingThreads;
+    for (int i = 0; i < nbPaintingThreads; i++) {
+        paintingThreads.push_back(thread([&] {
+            runStage("painting", queues, [&] {
+                runPaintingStage(trackedQueue, paintedQueue, writeFramesWhenPainted, queues);
+            });
+        }));
+    }
+    runStage("encoding", queues, [&] { runEncodingStage(paintedQueue, queues); });
+
+    decodingThread.join();
+    detectionThread.join();
+    trackingThread.join();
+    for (thread& paintingThread : paintingThreads) {
+        paintingThread.join();
+    }
+
+    if (stageError) {
+        std::rethrow_exception(stageError);
+    }
+
+    stringstream statistics;
+    for (size_t i = 0; i < queues.size(); i++) {
+        statistics << (i == 0 ? "" : ", ") << queueNames[i]
+            << " = avg " << queues[i]->averageSize()
+            << " / max " << queues[i]->maxSizeReached()
+            << " / capacity " << queues[i]->capacity();
+    }
+    LOG_INFO(logger) << "Processing pipeline completed (queue fill: " << statistics.str() << ").";
+}
+
+void VideoProcessorPipelineImpl::runDecodingStage(PipelineQueue& outputQueue) {
+    for (int frameIndex = firstFrameIndex; frameIndex < endFrameIndex; frameIndex++) {
+        PipelineItem item;
+        item.frameIndex = frameIndex;
+        item.frame = videoFrameReader.readFrameAt(frameIndex);
+
+        if (!outputQueue.push(std::move(item))) {
+            return;
+        }
+    }
+    outputQueue.close();
+}
+
+void VideoProcessorPipelineImpl::runDetectionStage(PipelineQueue& inputQueue, PipelineQueue& outputQueue) {
+    int batchSize = std::max(1, configuration.objectDetectionBatchSize);
+
+    PipelineItem item;
+    while (inputQueue.pop(item)) {
+        // Wait for the following frames in order to detect objects by batch
+        vector<PipelineItem> batchItems;
+        batchItems.push_back(std::move(item));
+        while ((int) batchItems.size() < batchSize && inputQueue.pop(item)) {
+            batchItems.push_back(std::move(item));
+        }
+
+        vector<cv::Mat> batchFrames;
+        for (const PipelineItem& batchItem : batchItems) {
+            batchFrames.push_back(batchItem.frame);
+        }
+        vector<vector<DetectedObject>> batchDetectedObjects =
+            objectDetector.detectObjectsAt(batchItems.front().frameIndex, batchFrames);
+
+        for (size_t i = 0; i < batchItems.size(); i++) {
+            batchItems[i].detectedObjects = std::move(batchDetectedObjects[i]);
+            if (!outputQueue.push(std::move(batchItems[i]))) {
+                return;
+            }
+        }
+    }
+    outputQueue.close();
+}
+
+void VideoProcessorPipelineImpl::runTrackingStage(PipelineQueue& inputQueue, PipelineQueue& outputQueue) {
+    FrameOffset accumulatedFrameOffset(0, 0);
+    vector<DetectedObject> prevFrameDetectedObjects;
+    std::list<Tip> tips;
+    std::list<Chopstick> chopsticks;
+
+    PipelineItem item;
+    while (inputQueue.pop(item)) {
+        // Find how much we need to compensate for camera motion
+        FrameOffset frameOffset(0, 0);
+        if (item.frameIndex > firstFrameIndex) {
+            frameOffset = trackerTip.computeOffsetToCompensateForCameraMotion(
+                prevFrameDetectedObjects, item.detectedObjects);
+            accumulatedFrameOffset += frameOffset;
+        }
+        prevFrameDetectedObjects = item.detectedObjects;
+
+        // Update the tracked tips and chopsticks
+        trackerTip.updateTipsWithNewDetectionResult(
+            tips, item.detectedObjects, item.frameIndex, frameOffset, accumulatedFrameOffset);
+
+        trackerChopstick.updateChopsticksWithNewDetectionResult(
+            chopsticks, tips, item.detectedObjects, accumulatedFrameOffset);
+
+        // Give a snapshot of the tracked objects to the painting stage
+        item.tips = tips;
+        item.chopsticks = std::list<Chopstick>(chopsticks);
+        item.accumulatedFrameOffset = accumulatedFrameOffset;
+
+        if (!outputQueue.push(std::move(item))) {
+            return;
+        }
+    }
+    outputQueue.close();
+}
+
+void VideoProcessorPipelineImpl::runPaintingStage(
+    PipelineQueue& inputQueue,
+    PipelineQueue& outputQueue,
+    bool writeFrames,
+    const vector<PipelineQueue*>& queues) {
+
+    PipelineItem item;
+    while (inputQueue.pop(item)) {
+        // Each frame needs its own output frame, because the previous one may still be encoding
+        item.outputFrame = videoFrameWriter.buildOutputFrame();
+
+        try {
+            videoFramePainterImage.paintOnFrame(
+                item.outputFrame, item.frame, item.accumulatedFrameOffset);
+            videoFramePainterDetectedObjects.paintOnFrame(
+                item.outputFrame, item.detectedObjects, item.accumulatedFrameOffset);
+            videoFramePainterTrackedObjects.paintOnFrame(
+                item.outputFrame, item.tips, item.chopsticks, item.accumulatedFrameOffset);
+
+            if (writeFrames) {
+                videoFrameWriter.writeFrameAt(item.frameIndex - firstFrameIndex, item.outputFrame);
+            }
+        } catch (...) {
+            // Note: nothing is done if the writer already owns the frame
+            videoFrameWriter.discardOutputFrame(item.outputFrame);
+            throw;
+        }
+
+        if (writeFrames) {
+            LOG_INFO(logger) << "Frame " << item.frameIndex << "/" << (endFrameIndex - 1)
+                << " processed (queue fill: " << describeQueueFill(queues) << ").";
+            continue;
+        }
+
+        // Release the memory that is not necessary anymore
+        item.frame.release();
+        item.tips.clear();
+        item.chopsticks.clear();
+
+        if (!outputQueue.push(std::move(item))) {
+            return;
+        }
+    }
+
+    // The last painting thread to finish closes the queue
+    if (--nbRunningPaintingThreads == 0) {
+        outputQueue.close();
+    }
+}
+
+void VideoProcessorPipelineImpl::runEncodingStage(
+    PipelineQueue& inputQueue, const vector<PipelineQueue*>& queues) {
+
+    PipelineItem item;
+    while (inputQueue.pop(item)) {
+        videoFrameWriter.writeFrameAt(item.frameIndex - firstFrameIndex, item.outputFrame);
+
+        LOG_INFO(logger) << "Frame " << item.frameIndex << "/" << (endFrameIndex - 1)
+            << " processed (queue fill: " << describeQueueFill(queues) << ").";
+    }
+
+    videoFrameWriter.flush();
+}
+
+void VideoProcessorPipelineImpl::runStage(
+    const string& stageName,
+    const vector<PipelineQueue*>& queues,
+    function<void()> stage) {
+
+    try {
+        stage();
+    } catch (...) {
+        LOG_ERROR(logger) << "The " << stageName << " stage failed, stop the pipeline.";
+        {
+            lock_guard<mutex> lock(stageErrorMutex);
+            if (!stageError) {
+                stageError = std::current_exception();
+            }
+        }
+        for (PipelineQueue* pQueue : queues) {
+            pQueue->cancel();
+        }
+
+        // Wake up the threads waiting for a missing frame in the writer
+        videoFrameWriter.cancel();
+    }
+}
+
+string VideoProcessorPipelineImpl::describeQueueFill(const vector<PipelineQueue*>& queues) const {
+    stringstream description;
+    for (size_t i = 0; i < queues.size(); i++) {
+        description << (i == 0 ? "" : ", ") << queueNames[i]
+            << " = " << queues[i]->size() << "/" << queues[i]->capacity();
+    }
+    return description.str();
+}
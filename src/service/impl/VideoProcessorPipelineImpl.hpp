@@ -0,0 +1,136 @@
+#ifndef SERVICE_VIDEO_PROCESSOR_PIPELINE_IMPL
+#define SERVICE_VIDEO_PROCESSOR_PIPELINE_IMPL
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "../../model/Configuration.hpp"
+#include "../../model/VideoProperties.hpp"
+#include "../../model/detection/DetectedObject.hpp"
+#include "../../model/tracking/Chopstick.hpp"
+#include "../../model/tracking/FrameOffset.hpp"
+#include "../../model/tracking/Tip.hpp"
+#include "../../utils/BoundedQueue.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+#include "../TrackerChopstick.hpp"
+#include "../TrackerTip.hpp"
+#include "../VideoFramePainterDetectedObjects.hpp"
+#include "../VideoFramePainterImage.hpp"
+#include "../VideoFramePainterTrackedObjects.hpp"
+#include "../VideoFrameReader.hpp"
+#include "../VideoFrameWriter.hpp"
+#include "../VideoProcessor.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoProcessor} that runs each step (decode, detect, track, paint
+     * and encode) in its own thread. The stages are connected by bounded queues, so a slow stage
+     * blocks the previous ones instead of accumulating frames in memory. Only the frames between
+     * firstFrameIndex (inclusive) and endFrameIndex (exclusive) are processed, and the output frames are
+     * numbered from 0.
+     *
+     * Frames are processed in order by every stage, in particular the tracking stage, which is
+     * inherently sequential. The only exception is the painting stage when it runs with several
+     * threads: in this case each painting thread writes its frames directly, so the
+     * {@link VideoFrameWriter} must accept frames out of order.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoProcessorPipelineImpl : public VideoProcessor {
+        private:
+            struct PipelineItem {
+                int frameIndex = -1;
+                cv::Mat frame;
+                std::vector<model::DetectedObject> detectedObjects;
+                std::list<model::Tip> tips;
+                std::list<model::Chopstick> chopsticks;
+                model::FrameOffset accumulatedFrameOffset;
+                cv::Mat outputFrame;
+            };
+
+            typedef utils::BoundedQueue<PipelineItem> PipelineQueue;
+
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const model::VideoProperties& videoProperties;
+            const int firstFrameIndex;
+            const int endFrameIndex;
+            VideoFrameReader& videoFrameReader;
+            ObjectDetector& objectDetector;
+            const TrackerTip& trackerTip;
+            const TrackerChopstick& trackerChopstick;
+            const VideoFramePainterImage& videoFramePainterImage;
+            const VideoFramePainterDetectedObjects& videoFramePainterDetectedObjects;
+            const VideoFramePainterTrackedObjects& videoFramePainterTrackedObjects;
+            VideoFrameWriter& videoFrameWriter;
+
+            std::mutex stageErrorMutex;
+            std::exception_ptr stageError;
+
+            std::atomic<int> nbRunningPaintingThreads{0};
+
+        public:
+            VideoProcessorPipelineImpl(
+                const model::Configuration& configuration,
+                const model::VideoProperties& videoProperties,
+                int firstFrameIndex,
+                int endFrameIndex,
+                VideoFrameReader& videoFrameReader,
+                ObjectDetector& objectDetector,
+                const TrackerTip& trackerTip,
+                const TrackerChopstick& trackerChopstick,
+                const VideoFramePainterImage& videoFramePainterImage,
+                const VideoFramePainterDetectedObjects& videoFramePainterDetectedObjects,
+                const VideoFramePainterTrackedObjects& videoFramePainterTrackedObjects,
+                VideoFrameWriter& videoFrameWriter) :
+                    configuration(configuration),
+                    videoProperties(videoProperties),
+                    firstFrameIndex(firstFrameIndex),
+                    endFrameIndex(endFrameIndex),
+                    videoFrameReader(videoFrameReader),
+                    objectDetector(objectDetector),
+                    trackerTip(trackerTip),
+                    trackerChopstick(trackerChopstick),
+                    videoFramePainterImage(videoFramePainterImage),
+                    videoFramePainterDetectedObjects(videoFramePainterDetectedObjects),
+                    videoFramePainterTrackedObjects(videoFramePainterTrackedObjects),
+                    videoFrameWriter(videoFrameWriter) {}
+
+            virtual ~VideoProcessorPipelineImpl() {}
+
+            virtual void processVideo();
+
+        private:
+            void runDecodingStage(PipelineQueue& outputQueue);
+            void runDetectionStage(PipelineQueue& inputQueue, PipelineQueue& outputQueue);
+            void runTrackingStage(PipelineQueue& inputQueue, PipelineQueue& outputQueue);
+            void runPaintingStage(
+                PipelineQueue& inputQueue,
+                PipelineQueue& outputQueue,
+                bool writeFrames,
+                const std::vector<PipelineQueue*>& queues);
+            void runEncodingStage(PipelineQueue& inputQueue, const std::vector<PipelineQueue*>& queues);
+
+            /**
+             * Execute the given stage and make sure the other stages are stopped if it fails.
+             */
+            void runStage(
+                const std::string& stageName,
+                const std::vector<PipelineQueue*>& queues,
+                std::function<void()> stage);
+
+            std::string describeQueueFill(const std::vector<PipelineQueue*>& queues) const;
+    };
+
+}
+
+#endif // SERVICE_VIDEO_PROCESSOR_PIPELINE_IMPL
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <list>
+#include <vector>
+#include "VideoProcessorSequentialImpl.hpp"
+
+using namespace model;
+using namespace service;
+using std::list;
+using std::vector;
+
+void VideoProcessorSequentialImpl::processVideo() {
+    FrameOffset accumulatedFrameOffset(0, 0);
+    vector<DetectedObject> detectedObjects;
+    vector<DetectedObject> prevFrameDetectedObjects;
+    list<Tip> tips;
+    list<Chopstick> chopsticks;
+
+    int batchSize = std::max(1, configuration.objectDetectionBatchSize);
+    int batchFirstFrameIndex = firstFrameIndex;
+    vector<cv::Mat> batchFrames;
+    vector<vector<DetectedObject>> batchDetectedObjects;
+
+    for (int frameIndex = firstFrameIndex; frameIndex < endFrameIndex; frameIndex++) {
+        LOG_INFO(logger) << "Processing the frame " << frameIndex
+            << "/" << (endFrameIndex - 1) << "...";
+
+        // Read the next frames and detect their objects by batch
+        if (frameIndex >= batchFirstFrameIndex + (int) batchFrames.size()) {
+            batchFirstFrameIndex = frameIndex;
+            int nbFrames = std::min(batchSize, endFrameIndex - frameIndex);
+            batchFrames.clear();
+            for (int i = 0; i < nbFrames; i++) {
+                batchFrames.push_back(videoFrameReader.readFrameAt(frameIndex + i));
+            }
+            if (!pRegionOfInterestDetector) {
+                batchDetectedObjects = objectDetector.detectObjectsAt(frameIndex, batchFrames);
+            }
+        }
+        const cv::Mat& frame = batchFrames[frameIndex - batchFirstFrameIndex];
+
+        // Note: the region of interest detector needs the objects tracked until the previous frame
+        prevFrameDetectedObjects = detectedObjects;
+        if (pRegionOfInterestDetector) {
+            detectedObjects = pRegionOfInterestDetector->detectObjectsAt(
+                frameIndex, frame, tips, chopsticks, prevFrameDetectedObjects, accumulatedFrameOffset);
+        } else {
+            detectedObjects = batchDetectedObjects[frameIndex - batchFirstFrameIndex];
+        }
+
+        // Find how much we need to compensate for camera motion
+        FrameOffset frameOffset(0, 0);
+        if (frameIndex > firstFrameIndex) {
+            frameOffset = trackerTip.computeOffsetToCompensateForCameraMotion(
+                prevFrameDetectedObjects, detectedObjects);
+            accumulatedFrameOffset += frameOffset;
+        }
+
+        // Update the tracked tips and chopsticks
+        trackerTip.updateTipsWithNewDetectionResult(
+            tips, detectedObjects, frameIndex, frameOffset, accumulatedFrameOffset);
+
+        trackerChopstick.updateChopsticksWithNewDetectionResult(
+            chopsticks, tips, detectedObjects, accumulatedFrameOffset);
+
+        // Render the detected and tracked objects in an output video frame
+        cv::Mat outputFrame = videoFrameWriter.buildOutputFrame();
+        videoFramePainterImage.paintOnFrame(outputFrame, frame, accumulatedFrameOffset);
+        videoFramePainterDetectedObjects.paintOnFrame(outputFrame, detectedObjects, accumulatedFrameOffset);
+        videoFramePainterTrackedObjects.paintOnFrame(outputFrame, tips, chopsticks, accumulatedFrameOffset);
+
+        videoFrameWriter.writeFrameAt(frameIndex - firstFrameIndex, outputFrame);
+    }
+
+    videoFrameWriter.flush();
+}
@@ -0,0 +1,83 @@
+#ifndef SERVICE_VIDEO_PROCESSOR_SEQUENTIAL_IMPL
+#define SERVICE_VIDEO_PROCESSOR_SEQUENTIAL_IMPL
+
+#include "../../model/Configuration.hpp"
+#include "../../model/VideoProperties.hpp"
+#include "../../utils/logging.hpp"
+#include "../ObjectDetector.hpp"
+#include "../RegionOfInterestDetector.hpp"
+#include "../TrackerChopstick.hpp"
+#include "../TrackerTip.hpp"
+#include "../VideoFramePainterDetectedObjects.hpp"
+#include "../VideoFramePainterImage.hpp"
+#include "../VideoFramePainterTrackedObjects.hpp"
+#include "../VideoFrameReader.hpp"
+#include "../VideoFrameWriter.hpp"
+#include "../VideoProcessor.hpp"
+
+namespace service {
+
+    /**
+     * Implementation of the {@link VideoProcessor} that reads, detects, tracks, paints and writes
+     * the video frames between firstFrameIndex (inclusive) and endFrameIndex (exclusive) one after the other
+     * in the calling thread. The output frames are numbered from 0. Objects are detected by batches of
+     * objectDetection.batchSize frames, or one by one around the tracked objects when a
+     * {@link RegionOfInterestDetector} is given.
+     *
+     * @author Marc Plouhinec
+     */
+    class VideoProcessorSequentialImpl : public VideoProcessor {
+        private:
+            boost::log::sources::severity_logger<boost::log::trivial::severity_level> logger;
+
+            const model::Configuration& configuration;
+            const model::VideoProperties& videoProperties;
+            const int firstFrameIndex;
+            const int endFrameIndex;
+            VideoFrameReader& videoFrameReader;
+            ObjectDetector& objectDetector;
+            const TrackerTip& trackerTip;
+            const TrackerChopstick& trackerChopstick;
+            const VideoFramePainterImage& videoFramePainterImage;
+            const VideoFramePainterDetectedObjects& videoFramePainterDetectedObjects;
+            const VideoFramePainterTrackedObjects& videoFramePainterTrackedObjects;
+            VideoFrameWriter& videoFrameWriter;
+            RegionOfInterestDetector* pRegionOfInterestDetector;
+
+        public:
+            VideoProcessorSequentialImpl(
+                const model::Configuration& configuration,
+                const model::VideoProperties& videoProperties,
+                int firstFrameIndex,
+                int endFrameIndex,
+                VideoFrameReader& videoFrameReader,
+                ObjectDetector& objectDetector,
+                const TrackerTip& trackerTip,
+                const TrackerChopstick& trackerChopstick,
+                const VideoFramePainterImage& videoFramePainterImage,
+                const VideoFramePainterDetectedObjects& videoFramePainterDetectedObjects,
+                const VideoFramePainterTrackedObjects& videoFramePainterTrackedObjects,
+                VideoFrameWriter& videoFrameWriter,
+                RegionOfInterestDetector* pRegionOfInterestDetector = nullptr) :
+                    configuration(configuration),
+                    videoProperties(videoProperties),
+                    firstFrameIndex(firstFrameIndex),
+                    endFrameIndex(endFrameIndex),
+                    videoFrameReader(videoFrameReader),
+                    objectDetector(objectDetector),
+                    trackerTip(trackerTip),
+                    trackerChopstick(trackerChopstick),
+                    videoFramePainterImage(videoFramePainterImage),
+                    videoFramePainterDetectedObjects(videoFramePainterDetectedObjects),
+                    videoFramePainterTrackedObjects(videoFramePainterTrackedObjects),
+                    videoFrameWriter(videoFrameWriter),
+                    pRegionOfInterestDetector(pRegionOfInterestDetector) {}
+
+            virtual ~VideoProcessorSequentialImpl() {}
+
+            virtual void processVideo();
+    };
+
+}
+
+#endif // SERVICE_VIDEO_PROCESSOR_SEQUENTIAL_IMPL
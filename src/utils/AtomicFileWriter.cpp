@@ -0,0 +1,24 @@
+#include <fstream>
+#include <stdexcept>
+#include "AtomicFileWriter.hpp"
+
+using namespace utils;
+using std::ofstream;
+using std::runtime_error;
+using std::string;
+namespace fs = boost::filesystem;
+
+void AtomicFileWriter::write(const fs::path& path, const string& content) {
+    fs::path temporaryPath = path.parent_path() / fs::unique_path(path.filename().string() + ".tmp-%%%%-%%%%-%%%%");
+
+    ofstream temporaryFile(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+    temporaryFile << content;
+    temporaryFile.close();
+    if (!temporaryFile) {
+        fs::remove(temporaryPath);
+        throw runtime_error("Unable to write the file: " + temporaryPath.string());
+    }
+
+    // Note: rename is atomic when both paths are on the same file system
+    fs::rename(temporaryPath, path);
+}
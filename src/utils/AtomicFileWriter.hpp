@@ -0,0 +1,25 @@
+#ifndef UTILS_ATOMIC_FILE_WRITER
+#define UTILS_ATOMIC_FILE_WRITER
+
+#include <string>
+#include <boost/filesystem.hpp>
+
+namespace utils {
+
+    /**
+     * Write files in a way that other threads or processes never see them partially written:
+     * the content is written into a temporary file in the same folder, then renamed.
+     *
+     * @author Marc Plouhinec
+     */
+    class AtomicFileWriter {
+        public:
+            /**
+             * Write the given content into the given file, replacing any existing file.
+             */
+            static void write(const boost::filesystem::path& path, const std::string& content);
+    };
+
+}
+
+#endif // UTILS_ATOMIC_FILE_WRITER
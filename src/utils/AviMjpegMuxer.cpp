@@ -0,0 +1,209 @@
+#include <limits>
+#include <stdexcept>
+#include "AviMjpegMuxer.hpp"
+
+using namespace utils;
+using std::runtime_error;
+using std::streamoff;
+using std::string;
+using std::vector;
+
+static const uint32_t AVIF_HASINDEX = 0x10;
+static const uint32_t AVIIF_KEYFRAME = 0x10;
+static const uint32_t MAIN_HEADER_SIZE = 56;
+static const uint32_t STREAM_HEADER_SIZE = 56;
+static const uint32_t STREAM_FORMAT_SIZE = 40;
+static const uint32_t INDEX_ENTRY_SIZE = 16;
+
+AviMjpegMuxer::~AviMjpegMuxer() {
+    if (isOpen()) {
+        try {
+            close();
+        } catch (const std::exception& e) {
+            // Nothing more can be done in a destructor
+        }
+    }
+}
+
+void AviMjpegMuxer::open(const string& path, int frameWidth, int frameHeight, int fps) {
+    this->outputPath = path;
+    this->frameWidth = frameWidth;
+    this->frameHeight = frameHeight;
+    this->fps = fps;
+    indexEntries.clear();
+    maxFrameSize = 0;
+
+    outputStream.open(path, std::ios::binary | std::ios::trunc);
+    if (!outputStream.is_open()) {
+        throw runtime_error("Unable to create the file: " + path);
+    }
+
+    // The sizes and frame counts are completed when the file is closed
+    writeFourcc("RIFF");
+    riffSizePosition = outputStream.tellp();
+    writeUint32(0);
+    writeFourcc("AVI ");
+
+    writeFourcc("LIST");
+    writeUint32(4 + (8 + MAIN_HEADER_SIZE) + (8 + 4 + (8 + STREAM_HEADER_SIZE) + (8 + STREAM_FORMAT_SIZE)));
+    writeFourcc("hdrl");
+    writeMainHeader();
+
+    writeFourcc("LIST");
+    writeUint32(4 + (8 + STREAM_HEADER_SIZE) + (8 + STREAM_FORMAT_SIZE));
+    writeFourcc("strl");
+    writeStreamHeader();
+    writeStreamFormat();
+
+    writeFourcc("LIST");
+    moviListSizePosition = outputStream.tellp();
+    writeUint32(0);
+    moviFourccPosition = outputStream.tellp();
+    writeFourcc("movi");
+}
+
+void AviMjpegMuxer::writeFrame(const vector<unsigned char>& jpegData) {
+    uint32_t frameSize = jpegData.size();
+    uint32_t paddedFrameSize = frameSize + (frameSize % 2);
+
+    // Make sure the file, including the index, stays under the RIFF size limit
+    uint64_t chunkPosition = outputStream.tellp();
+    uint64_t expectedFileSize = chunkPosition + 8 + paddedFrameSize
+        + 8 + (uint64_t) (indexEntries.size() + 1) * INDEX_ENTRY_SIZE;
+    if (expectedFileSize > std::numeric_limits<uint32_t>::max()) {
+        throw runtime_error("The AVI file is too large (the limit is 4 GB): " + outputPath);
+    }
+
+    writeFourcc("00dc");
+    writeUint32(frameSize);
+    outputStream.write(reinterpret_cast<const char*>(jpegData.data()), frameSize);
+    if (paddedFrameSize != frameSize) {
+        outputStream.put(0);
+    }
+    if (!outputStream) {
+        throw runtime_error("Unable to write into the file: " + outputPath);
+    }
+
+    indexEntries.push_back({ (uint32_t) (chunkPosition - moviFourccPosition), frameSize });
+    if (frameSize > maxFrameSize) {
+        maxFrameSize = frameSize;
+    }
+}
+
+void AviMjpegMuxer::close() {
+    // Complete the "movi" list
+    streamoff indexPosition = outputStream.tellp();
+    overwriteUint32(moviListSizePosition, indexPosition - moviFourccPosition);
+
+    // Write the index
+    outputStream.seekp(indexPosition);
+    writeFourcc("idx1");
+    writeUint32(indexEntries.size() * INDEX_ENTRY_SIZE);
+    for (const IndexEntry& indexEntry : indexEntries) {
+        writeFourcc("00dc");
+        writeUint32(AVIIF_KEYFRAME);
+        writeUint32(indexEntry.offset);
+        writeUint32(indexEntry.size);
+    }
+
+    // Complete the headers
+    streamoff fileSize = outputStream.tellp();
+    overwriteUint32(riffSizePosition, fileSize - 8);
+    outputStream.seekp(avihPosition);
+    writeMainHeader();
+    outputStream.seekp(strhPosition);
+    writeStreamHeader();
+
+    outputStream.close();
+    if (outputStream.fail()) {
+        throw runtime_error("Unable to write into the file: " + outputPath);
+    }
+}
+
+void AviMjpegMuxer::writeMainHeader() {
+    avihPosition = outputStream.tellp();
+    uint32_t nbFrames = indexEntries.size();
+
+    writeFourcc("avih");
+    writeUint32(MAIN_HEADER_SIZE);
+    writeUint32(fps > 0 ? 1000000 / fps : 0); // dwMicroSecPerFrame
+    writeUint32(maxFrameSize * fps);          // dwMaxBytesPerSec
+    writeUint32(0);                           // dwPaddingGranularity
+    writeUint32(AVIF_HASINDEX);               // dwFlags
+    writeUint32(nbFrames);                    // dwTotalFrames
+    writeUint32(0);                           // dwInitialFrames
+    writeUint32(1);                           // dwStreams
+    writeUint32(maxFrameSize);                // dwSuggestedBufferSize
+    writeUint32(frameWidth);                  // dwWidth
+    writeUint32(frameHeight);                 // dwHeight
+    for (int i = 0; i < 4; i++) {
+        writeUint32(0);                       // dwReserved
+    }
+}
+
+void AviMjpegMuxer::writeStreamHeader() {
+    strhPosition = outputStream.tellp();
+    uint32_t nbFrames = indexEntries.size();
+
+    writeFourcc("strh");
+    writeUint32(STREAM_HEADER_SIZE);
+    writeFourcc("vids");                      // fccType
+    writeFourcc("MJPG");                      // fccHandler
+    writeUint32(0);                           // dwFlags
+    writeUint16(0);                           // wPriority
+    writeUint16(0);                           // wLanguage
+    writeUint32(0);                           // dwInitialFrames
+    writeUint32(1);                           // dwScale
+    writeUint32(fps);                         // dwRate
+    writeUint32(0);                           // dwStart
+    writeUint32(nbFrames);                    // dwLength
+    writeUint32(maxFrameSize);                // dwSuggestedBufferSize
+    writeUint32(0xFFFFFFFF);                  // dwQuality
+    writeUint32(0);                           // dwSampleSize
+    writeUint16(0);                           // rcFrame.left
+    writeUint16(0);                           // rcFrame.top
+    writeUint16(frameWidth);                  // rcFrame.right
+    writeUint16(frameHeight);                 // rcFrame.bottom
+}
+
+void AviMjpegMuxer::writeStreamFormat() {
+    writeFourcc("strf");
+    writeUint32(STREAM_FORMAT_SIZE);
+    writeUint32(STREAM_FORMAT_SIZE);          // biSize
+    writeUint32(frameWidth);                  // biWidth
+    writeUint32(frameHeight);                 // biHeight
+    writeUint16(1);                           // biPlanes
+    writeUint16(24);                          // biBitCount
+    writeFourcc("MJPG");                      // biCompression
+    writeUint32(frameWidth * frameHeight * 3);// biSizeImage
+    writeUint32(0);                           // biXPelsPerMeter
+    writeUint32(0);                           // biYPelsPerMeter
+    writeUint32(0);                           // biClrUsed
+    writeUint32(0);                           // biClrImportant
+}
+
+void AviMjpegMuxer::writeFourcc(const char* fourcc) {
+    outputStream.write(fourcc, 4);
+}
+
+void AviMjpegMuxer::writeUint32(uint32_t value) {
+    char bytes[4] = {
+        (char) (value & 0xFF),
+        (char) ((value >> 8) & 0xFF),
+        (char) ((value >> 16) & 0xFF),
+        (char) ((value >> 24) & 0xFF)
+    };
+    outputStream.write(bytes, 4);
+}
+
+void AviMjpegMuxer::writeUint16(uint16_t value) {
+    char bytes[2] = { (char) (value & 0xFF), (char) ((value >> 8) & 0xFF) };
+    outputStream.write(bytes, 2);
+}
+
+void AviMjpegMuxer::overwriteUint32(streamoff position, uint32_t value) {
+    streamoff currentPosition = outputStream.tellp();
+    outputStream.seekp(position);
+    writeUint32(value);
+    outputStream.seekp(currentPosition);
+}
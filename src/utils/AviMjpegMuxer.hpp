@@ -0,0 +1,83 @@
+#ifndef UTILS_AVI_MJPEG_MUXER
+#define UTILS_AVI_MJPEG_MUXER
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+    /**
+     * Write JPEG images into an AVI file (RIFF container with a single MJPG video stream and
+     * an "idx1" index), in the same format as the files produced by cv::VideoWriter with the
+     * MJPG codec.
+     *
+     * Note: only the AVI 1.0 format is supported, so the file size is limited to 4 GB.
+     *
+     * @author Marc Plouhinec
+     */
+    class AviMjpegMuxer {
+        private:
+            struct IndexEntry {
+                uint32_t offset;
+                uint32_t size;
+            };
+
+        private:
+            std::ofstream outputStream;
+            std::string outputPath;
+            int frameWidth = 0;
+            int frameHeight = 0;
+            int fps = 0;
+
+            std::vector<IndexEntry> indexEntries;
+            uint32_t maxFrameSize = 0;
+
+            std::streamoff riffSizePosition = 0;
+            std::streamoff avihPosition = 0;
+            std::streamoff strhPosition = 0;
+            std::streamoff moviListSizePosition = 0;
+            std::streamoff moviFourccPosition = 0;
+
+        public:
+            AviMjpegMuxer() {}
+
+            ~AviMjpegMuxer();
+
+            /**
+             * Create the file and write its headers.
+             */
+            void open(const std::string& path, int frameWidth, int frameHeight, int fps);
+
+            /**
+             * Append a JPEG image at the end of the video.
+             */
+            void writeFrame(const std::vector<unsigned char>& jpegData);
+
+            /**
+             * Write the index, complete the headers and close the file.
+             */
+            void close();
+
+            bool isOpen() const {
+                return outputStream.is_open();
+            }
+
+            int getNbFrames() const {
+                return indexEntries.size();
+            }
+
+        private:
+            void writeFourcc(const char* fourcc);
+            void writeUint32(uint32_t value);
+            void writeUint16(uint16_t value);
+            void overwriteUint32(std::streamoff position, uint32_t value);
+            void writeMainHeader();
+            void writeStreamHeader();
+            void writeStreamFormat();
+    };
+
+}
+
+#endif // UTILS_AVI_MJPEG_MUXER
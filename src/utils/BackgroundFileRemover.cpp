@@ -0,0 +1,35 @@
+#include <stdexcept>
+#include "BackgroundFileRemover.hpp"
+
+using namespace utils;
+using std::lock_guard;
+using std::mutex;
+using std::runtime_error;
+using std::thread;
+namespace fs = boost::filesystem;
+
+BackgroundFileRemover::~BackgroundFileRemover() {
+    lock_guard<mutex> lock(threadsMutex);
+    for (thread& removalThread : removalThreads) {
+        removalThread.join();
+    }
+}
+
+void BackgroundFileRemover::remove(const fs::path& path) {
+    if (!fs::exists(path)) {
+        return;
+    }
+
+    fs::path renamedPath = path.parent_path() / fs::unique_path(path.filename().string() + ".deleting-%%%%-%%%%");
+    boost::system::error_code errorCode;
+    fs::rename(path, renamedPath, errorCode);
+    if (errorCode) {
+        throw runtime_error("Unable to rename " + path.string() + ": " + errorCode.message());
+    }
+
+    lock_guard<mutex> lock(threadsMutex);
+    removalThreads.push_back(thread([renamedPath] {
+        boost::system::error_code ignoredErrorCode;
+        fs::remove_all(renamedPath, ignoredErrorCode);
+    }));
+}
@@ -0,0 +1,37 @@
+#ifndef UTILS_BACKGROUND_FILE_REMOVER
+#define UTILS_BACKGROUND_FILE_REMOVER
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+namespace utils {
+
+    /**
+     * Remove files or folders without blocking the caller: the path is first renamed (so it can be
+     * immediately replaced), then deleted in a background thread. The destructor waits until all
+     * the deletions are completed.
+     *
+     * @author Marc Plouhinec
+     */
+    class BackgroundFileRemover {
+        private:
+            std::mutex threadsMutex;
+            std::vector<std::thread> removalThreads;
+
+        public:
+            BackgroundFileRemover() {}
+
+            ~BackgroundFileRemover();
+
+            /**
+             * Rename the given file or folder, then delete it in the background.
+             * Do nothing if the path doesn't exist.
+             */
+            void remove(const boost::filesystem::path& path);
+    };
+
+}
+
+#endif // UTILS_BACKGROUND_FILE_REMOVER
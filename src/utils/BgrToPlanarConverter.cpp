@@ -0,0 +1,175 @@
+#include <stdexcept>
+#include "BgrToPlanarConverter.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BGR_TO_PLANAR_X86
+#endif
+
+using namespace utils;
+using std::runtime_error;
+using std::string;
+
+namespace {
+
+    /**
+     * Convert one row of pixels, without SIMD instructions. Used for the whole row when SIMD instructions
+     * are not available, and for the last pixels of the row otherwise.
+     */
+    void convertRowScalar(
+        const uchar* pBgr, int firstX, int endX, float* pRed, float* pGreen, float* pBlue, float scale) {
+
+        for (int x = firstX; x < endX; x++) {
+            pBlue[x] = pBgr[x * 3] * scale;
+            pGreen[x] = pBgr[x * 3 + 1] * scale;
+            pRed[x] = pBgr[x * 3 + 2] * scale;
+        }
+    }
+
+#ifdef BGR_TO_PLANAR_X86
+
+    /**
+     * Build the masks for _mm_shuffle_epi8 that gather one channel of 16 interleaved BGR pixels
+     * (48 bytes loaded into 3 registers) into one register.
+     */
+    struct DeinterleaveMasks {
+        // [channel][register]
+        alignas(16) signed char masks[3][3][16];
+
+        DeinterleaveMasks() {
+            for (int channel = 0; channel < 3; channel++) {
+                for (int reg = 0; reg < 3; reg++) {
+                    for (int i = 0; i < 16; i++) {
+                        int byteIndex = i * 3 + channel - reg * 16;
+                        masks[channel][reg][i] = (byteIndex >= 0 && byteIndex < 16) ? byteIndex : -1;
+                    }
+                }
+            }
+        }
+    };
+
+    const DeinterleaveMasks deinterleaveMasks;
+
+    __attribute__((target("ssse3")))
+    inline void deinterleave16Pixels(const uchar* pBgr, __m128i& blue, __m128i& green, __m128i& red) {
+        __m128i bytes0 = _mm_loadu_si128((const __m128i*) pBgr);
+        __m128i bytes1 = _mm_loadu_si128((const __m128i*) (pBgr + 16));
+        __m128i bytes2 = _mm_loadu_si128((const __m128i*) (pBgr + 32));
+
+        __m128i* channels[3] = { &blue, &green, &red };
+        for (int channel = 0; channel < 3; channel++) {
+            const __m128i* pMasks = (const __m128i*) deinterleaveMasks.masks[channel];
+            *channels[channel] = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_shuffle_epi8(bytes0, _mm_load_si128(pMasks)),
+                    _mm_shuffle_epi8(bytes1, _mm_load_si128(pMasks + 1))),
+                _mm_shuffle_epi8(bytes2, _mm_load_si128(pMasks + 2)));
+        }
+    }
+
+    __attribute__((target("ssse3")))
+    inline void storeScaled16Ssse3(__m128i values, float* pOutput, __m128 scale) {
+        __m128i zero = _mm_setzero_si128();
+        __m128i low16 = _mm_unpacklo_epi8(values, zero);
+        __m128i high16 = _mm_unpackhi_epi8(values, zero);
+        _mm_storeu_ps(pOutput, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low16, zero)), scale));
+        _mm_storeu_ps(pOutput + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low16, zero)), scale));
+        _mm_storeu_ps(pOutput + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high16, zero)), scale));
+        _mm_storeu_ps(pOutput + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high16, zero)), scale));
+    }
+
+    __attribute__((target("ssse3")))
+    void convertRowSsse3(const uchar* pBgr, int width, float* pRed, float* pGreen, float* pBlue, float scale) {
+        __m128 scaleVector = _mm_set1_ps(scale);
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            __m128i blue, green, red;
+            deinterleave16Pixels(pBgr + x * 3, blue, green, red);
+            storeScaled16Ssse3(blue, pBlue + x, scaleVector);
+            storeScaled16Ssse3(green, pGreen + x, scaleVector);
+            storeScaled16Ssse3(red, pRed + x, scaleVector);
+        }
+        convertRowScalar(pBgr, x, width, pRed, pGreen, pBlue, scale);
+    }
+
+    __attribute__((target("avx2")))
+    inline void storeScaled16Avx2(__m128i values, float* pOutput, __m256 scale) {
+        __m256 low = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values));
+        __m256 high = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, 8)));
+        _mm256_storeu_ps(pOutput, _mm256_mul_ps(low, scale));
+        _mm256_storeu_ps(pOutput + 8, _mm256_mul_ps(high, scale));
+    }
+
+    __attribute__((target("avx2")))
+    void convertRowAvx2(const uchar* pBgr, int width, float* pRed, float* pGreen, float* pBlue, float scale) {
+        __m256 scaleVector = _mm256_set1_ps(scale);
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            __m128i blue, green, red;
+            deinterleave16Pixels(pBgr + x * 3, blue, green, red);
+            storeScaled16Avx2(blue, pBlue + x, scaleVector);
+            storeScaled16Avx2(green, pGreen + x, scaleVector);
+            storeScaled16Avx2(red, pRed + x, scaleVector);
+        }
+        convertRowScalar(pBgr, x, width, pRed, pGreen, pBlue, scale);
+    }
+
+#endif // BGR_TO_PLANAR_X86
+
+    typedef void (*ConvertRowFunction)(const uchar*, int, float*, float*, float*, float);
+
+    void convertRowWithoutSimd(const uchar* pBgr, int width, float* pRed, float* pGreen, float* pBlue, float scale) {
+        convertRowScalar(pBgr, 0, width, pRed, pGreen, pBlue, scale);
+    }
+
+    ConvertRowFunction selectConvertRowFunction() {
+#ifdef BGR_TO_PLANAR_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return convertRowAvx2;
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            return convertRowSsse3;
+        }
+#endif
+        return convertRowWithoutSimd;
+    }
+
+    const ConvertRowFunction convertRow = selectConvertRowFunction();
+
+}
+
+void BgrToPlanarConverter::convert(const cv::Mat& bgrImage, float* pOutput, float scale) {
+    if (bgrImage.type() != CV_8UC3) {
+        throw runtime_error("Only CV_8UC3 images can be converted.");
+    }
+
+    int width = bgrImage.cols;
+    int height = bgrImage.rows;
+    size_t planeSize = (size_t) width * height;
+    float* pRedPlane = pOutput;
+    float* pGreenPlane = pOutput + planeSize;
+    float* pBluePlane = pOutput + 2 * planeSize;
+
+    // Each thread converts a block of rows (about 64 rows per block)
+    cv::parallel_for_(cv::Range(0, height), [&](const cv::Range& rowRange) {
+        for (int y = rowRange.start; y < rowRange.end; y++) {
+            size_t rowOffset = (size_t) y * width;
+            convertRow(
+                bgrImage.ptr<uchar>(y), width,
+                pRedPlane + rowOffset, pGreenPlane + rowOffset, pBluePlane + rowOffset, scale);
+        }
+    }, height / 64.0);
+}
+
+string BgrToPlanarConverter::getInstructionSetName() {
+#ifdef BGR_TO_PLANAR_X86
+    if (convertRow == convertRowAvx2) {
+        return "AVX2";
+    }
+    if (convertRow == convertRowSsse3) {
+        return "SSSE3";
+    }
+#endif
+    return "scalar";
+}
@@ -0,0 +1,36 @@
+#ifndef UTILS_BGR_TO_PLANAR_CONVERTER
+#define UTILS_BGR_TO_PLANAR_CONVERTER
+
+#include <string>
+#include <opencv2/opencv.hpp>
+
+namespace utils {
+
+    /**
+     * Convert 8-bit BGR images (interleaved, as stored by OpenCV) into 32-bit float planar RGB images
+     * (all the red values, then all the green values, then all the blue values, as expected by Darknet
+     * and most neural networks), while multiplying each value by a scale factor.
+     *
+     * The conversion is done in a single pass with SIMD instructions (AVX2 or SSSE3, selected at runtime
+     * depending on the CPU, with a scalar fallback), and the rows are shared among several threads.
+     *
+     * @author Marc Plouhinec
+     */
+    class BgrToPlanarConverter {
+        public:
+            /**
+             * @param bgrImage Image of type CV_8UC3.
+             * @param pOutput Buffer of at least 3 * bgrImage.cols * bgrImage.rows floats.
+             * @param scale Factor applied to each value (for example 1 / 255.0 to get values between 0 and 1).
+             */
+            static void convert(const cv::Mat& bgrImage, float* pOutput, float scale);
+
+            /**
+             * @return Name of the instruction set used by {@link #convert()} on this CPU.
+             */
+            static std::string getInstructionSetName();
+    };
+
+}
+
+#endif // UTILS_BGR_TO_PLANAR_CONVERTER
@@ -0,0 +1,132 @@
+#ifndef UTILS_BOUNDED_QUEUE
+#define UTILS_BOUNDED_QUEUE
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace utils {
+
+    /**
+     * Thread-safe FIFO queue with a maximum capacity. Producers are blocked when the queue is full
+     * and consumers are blocked when it is empty (backpressure).
+     *
+     * A producer calls {@link #close()} when it has no more element to push: consumers can still
+     * pop the remaining elements, then {@link #pop(T&)} returns false. {@link #cancel()} is used when
+     * something goes wrong: pending elements are discarded and all blocked threads are released.
+     *
+     * @author Marc Plouhinec
+     */
+    template<typename T>
+    class BoundedQueue {
+        private:
+            const int maxSize;
+
+            mutable std::mutex mutex;
+            std::condition_variable notFullCondition;
+            std::condition_variable notEmptyCondition;
+            std::deque<T> elements;
+            bool closed = false;
+            bool cancelled = false;
+
+            long nbPushes = 0;
+            long sumSizesAtPush = 0;
+            int maxObservedSize = 0;
+
+        public:
+            explicit BoundedQueue(int maxSize) : maxSize(maxSize < 1 ? 1 : maxSize) {}
+
+            /**
+             * Add an element at the end of the queue. Block while the queue is full.
+             *
+             * @return false if the queue has been closed or cancelled (the element is dropped).
+             */
+            bool push(T element) {
+                std::unique_lock<std::mutex> lock(mutex);
+                notFullCondition.wait(lock, [this] {
+                    return cancelled || closed || (int) elements.size() < maxSize;
+                });
+                if (cancelled || closed) {
+                    return false;
+                }
+
+                elements.push_back(std::move(element));
+                nbPushes++;
+                sumSizesAtPush += elements.size();
+                if ((int) elements.size() > maxObservedSize) {
+                    maxObservedSize = elements.size();
+                }
+
+                lock.unlock();
+                notEmptyCondition.notify_one();
+                return true;
+            }
+
+            /**
+             * Remove the first element of the queue. Block while the queue is empty.
+             *
+             * @return false if there is no more element to expect (queue closed and empty, or cancelled).
+             */
+            bool pop(T& element) {
+                std::unique_lock<std::mutex> lock(mutex);
+                notEmptyCondition.wait(lock, [this] {
+                    return cancelled || closed || !elements.empty();
+                });
+                if (cancelled || elements.empty()) {
+                    return false;
+                }
+
+                element = std::move(elements.front());
+                elements.pop_front();
+
+                lock.unlock();
+                notFullCondition.notify_one();
+                return true;
+            }
+
+            void close() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    closed = true;
+                }
+                notFullCondition.notify_all();
+                notEmptyCondition.notify_all();
+            }
+
+            void cancel() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    cancelled = true;
+                    elements.clear();
+                }
+                notFullCondition.notify_all();
+                notEmptyCondition.notify_all();
+            }
+
+            int size() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return elements.size();
+            }
+
+            int capacity() const {
+                return maxSize;
+            }
+
+            /**
+             * @return Average number of elements in the queue right after a push.
+             */
+            double averageSize() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return nbPushes == 0 ? 0.0 : (double) sumSizesAtPush / nbPushes;
+            }
+
+            int maxSizeReached() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return maxObservedSize;
+            }
+    };
+
+}
+
+#endif // UTILS_BOUNDED_QUEUE
@@ -0,0 +1,91 @@
+#ifndef UTILS_DNN_BACKEND_HELPER
+#define UTILS_DNN_BACKEND_HELPER
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <opencv2/dnn.hpp>
+
+namespace utils {
+
+    /**
+     * Convert the OpenCV DNN backends and targets from / to the names used in the configuration file.
+     *
+     * @author Marc Plouhinec
+     */
+    class DnnBackendHelper {
+        public:
+            static std::vector<std::pair<std::string, int>> getBackendNames() {
+                return {
+                    { "default", cv::dnn::DNN_BACKEND_DEFAULT },
+                    { "opencv", cv::dnn::DNN_BACKEND_OPENCV },
+                    { "inferenceengine", cv::dnn::DNN_BACKEND_INFERENCE_ENGINE },
+                    { "halide", cv::dnn::DNN_BACKEND_HALIDE },
+                    { "vulkan", cv::dnn::DNN_BACKEND_VKCOM },
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 2)
+                    { "cuda", cv::dnn::DNN_BACKEND_CUDA },
+#endif
+                };
+            }
+
+            static std::vector<std::pair<std::string, int>> getTargetNames() {
+                return {
+                    { "cpu", cv::dnn::DNN_TARGET_CPU },
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 9)
+                    { "cpu_fp16", cv::dnn::DNN_TARGET_CPU_FP16 },
+#endif
+                    { "opencl", cv::dnn::DNN_TARGET_OPENCL },
+                    { "opencl_fp16", cv::dnn::DNN_TARGET_OPENCL_FP16 },
+                    { "myriad", cv::dnn::DNN_TARGET_MYRIAD },
+                    { "vulkan", cv::dnn::DNN_TARGET_VULKAN },
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 2)
+                    { "cuda", cv::dnn::DNN_TARGET_CUDA },
+                    { "cuda_fp16", cv::dnn::DNN_TARGET_CUDA_FP16 },
+#endif
+                };
+            }
+
+            static int stringToBackend(const std::string& name) {
+                return findValue(getBackendNames(), name, "backend");
+            }
+
+            static int stringToTarget(const std::string& name) {
+                return findValue(getTargetNames(), name, "target");
+            }
+
+            static std::string backendToString(int backend) {
+                return findName(getBackendNames(), backend);
+            }
+
+            static std::string targetToString(int target) {
+                return findName(getTargetNames(), target);
+            }
+
+        private:
+            static int findValue(
+                const std::vector<std::pair<std::string, int>>& names,
+                const std::string& name,
+                const std::string& kind) {
+
+                for (const auto& entry : names) {
+                    if (entry.first == name) {
+                        return entry.second;
+                    }
+                }
+                throw std::runtime_error("Unknown OpenCV DNN " + kind + ": " + name);
+            }
+
+            static std::string findName(const std::vector<std::pair<std::string, int>>& names, int value) {
+                for (const auto& entry : names) {
+                    if (entry.second == value) {
+                        return entry.first;
+                    }
+                }
+                return std::to_string(value);
+            }
+    };
+
+}
+
+#endif // UTILS_DNN_BACKEND_HELPER
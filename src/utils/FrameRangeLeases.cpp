@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include "AtomicFileWriter.hpp"
+#include "FrameRangeLeases.hpp"
+
+using namespace utils;
+using std::min;
+using std::runtime_error;
+using std::string;
+using std::stringstream;
+using std::to_string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+static string buildOwnerId() {
+    char hostName[256] = { 0 };
+    gethostname(hostName, sizeof(hostName) - 1);
+    return string(hostName) + ":" + to_string(getpid());
+}
+
+FrameRangeLeases::FrameRangeLeases(
+    const fs::path& folderPath,
+    int nbFrames,
+    int rangeSize,
+    int leaseTimeoutInSeconds) :
+        folderPath(folderPath),
+        nbFrames(nbFrames),
+        rangeSize(std::max(1, rangeSize)),
+        leaseTimeoutInSeconds(leaseTimeoutInSeconds),
+        ownerId(buildOwnerId()) {
+
+    boost::system::error_code errorCode;
+    fs::create_directories(folderPath, errorCode);
+    if (!fs::is_directory(folderPath)) {
+        throw runtime_error("Unable to create the directory: " + folderPath.string());
+    }
+}
+
+vector<FrameRangeLeases::FrameRange> FrameRangeLeases::getFrameRanges() const {
+    vector<FrameRange> frameRanges;
+    for (int firstFrameIndex = 0; firstFrameIndex < nbFrames; firstFrameIndex += rangeSize) {
+        FrameRange frameRange;
+        frameRange.firstFrameIndex = firstFrameIndex;
+        frameRange.endFrameIndex = min(nbFrames, firstFrameIndex + rangeSize);
+        frameRanges.push_back(frameRange);
+    }
+    return frameRanges;
+}
+
+FrameRangeLeases::RangeStatus FrameRangeLeases::getStatus(const FrameRange& frameRange) const {
+    if (fs::exists(getDonePath(frameRange))) {
+        return RangeStatus::DONE;
+    }
+
+    boost::system::error_code errorCode;
+    std::time_t lastWriteTime = fs::last_write_time(getLeasePath(frameRange), errorCode);
+    if (errorCode) {
+        return RangeStatus::PENDING;
+    }
+    return std::time(nullptr) - lastWriteTime > leaseTimeoutInSeconds ? RangeStatus::STALE : RangeStatus::LEASED;
+}
+
+bool FrameRangeLeases::tryAcquire(const FrameRange& frameRange) const {
+    // O_EXCL guarantees that only one process can create the lease file
+    string leasePath = getLeasePath(frameRange).string();
+    int fileDescriptor = open(leasePath.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+    if (fileDescriptor == -1) {
+        return false;
+    }
+
+    string content = ownerId + "\n";
+    bool written = ::write(fileDescriptor, content.c_str(), content.size()) == (ssize_t) content.size();
+    close(fileDescriptor);
+    if (!written) {
+        fs::remove(leasePath);
+        throw runtime_error("Unable to write the lease file: " + leasePath);
+    }
+
+    // Another process may have completed the range between the status check and the lease creation
+    if (fs::exists(getDonePath(frameRange))) {
+        fs::remove(leasePath);
+        return false;
+    }
+    return true;
+}
+
+bool FrameRangeLeases::renew(const FrameRange& frameRange) const {
+    if (!isLeaseOwned(frameRange)) {
+        return false;
+    }
+    boost::system::error_code errorCode;
+    fs::last_write_time(getLeasePath(frameRange), std::time(nullptr), errorCode);
+    return !errorCode;
+}
+
+void FrameRangeLeases::complete(const FrameRange& frameRange) const {
+    AtomicFileWriter::write(getDonePath(frameRange), ownerId + "\n");
+    release(frameRange);
+}
+
+void FrameRangeLeases::release(const FrameRange& frameRange) const {
+    // Note: a lease taken over by another process after being considered stale must not be deleted
+    if (isLeaseOwned(frameRange)) {
+        boost::system::error_code errorCode;
+        fs::remove(getLeasePath(frameRange), errorCode);
+    }
+}
+
+int FrameRangeLeases::releaseStaleLeases() const {
+    int nbReleasedLeases = 0;
+    for (const FrameRange& frameRange : getFrameRanges()) {
+        if (getStatus(frameRange) == RangeStatus::STALE) {
+            boost::system::error_code errorCode;
+            fs::remove(getLeasePath(frameRange), errorCode);
+            nbReleasedLeases++;
+        }
+    }
+    return nbReleasedLeases;
+}
+
+string FrameRangeLeases::describeProgress() const {
+    vector<FrameRange> frameRanges = getFrameRanges();
+    int nbDoneRanges = 0;
+    int nbDoneFrames = 0;
+    int nbLeasedRanges = 0;
+    int nbStaleRanges = 0;
+    for (const FrameRange& frameRange : frameRanges) {
+        switch (getStatus(frameRange)) {
+            case RangeStatus::DONE:
+                nbDoneRanges++;
+                nbDoneFrames += frameRange.endFrameIndex - frameRange.firstFrameIndex;
+                break;
+            case RangeStatus::LEASED:
+                nbLeasedRanges++;
+                break;
+            case RangeStatus::STALE:
+                nbStaleRanges++;
+                break;
+            case RangeStatus::PENDING:
+            default:
+                break;
+        }
+    }
+
+    stringstream progress;
+    progress << nbDoneRanges << "/" << frameRanges.size() << " ranges done ("
+        << nbDoneFrames << "/" << nbFrames << " frames), "
+        << nbLeasedRanges << " leased, " << nbStaleRanges << " stale";
+    return progress.str();
+}
+
+bool FrameRangeLeases::isLeaseOwned(const FrameRange& frameRange) const {
+    std::ifstream leaseStream(getLeasePath(frameRange).string());
+    string leaseOwnerId;
+    return std::getline(leaseStream, leaseOwnerId) && leaseOwnerId == ownerId;
+}
+
+fs::path FrameRangeLeases::getLeasePath(const FrameRange& frameRange) const {
+    return folderPath / (to_string(frameRange.firstFrameIndex) + "-"
+        + to_string(frameRange.endFrameIndex - 1) + ".lease");
+}
+
+fs::path FrameRangeLeases::getDonePath(const FrameRange& frameRange) const {
+    return folderPath / (to_string(frameRange.firstFrameIndex) + "-"
+        + to_string(frameRange.endFrameIndex - 1) + ".done");
+}
@@ -0,0 +1,103 @@
+#ifndef UTILS_FRAME_RANGE_LEASES
+#define UTILS_FRAME_RANGE_LEASES
+
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+namespace utils {
+
+    /**
+     * Share the frames of a video among several processes (on one machine or on several machines with a
+     * shared file system), by using files in a common folder:
+     * - "<first>-<last>.lease" is created exclusively by the process that claims the frame range, and
+     *   touched regularly while the range is being processed. It contains the host name and the process ID.
+     * - "<first>-<last>.done" is created when the range is fully processed.
+     *
+     * A lease that has not been touched for more than leaseTimeoutInSeconds is considered stale
+     * (the process probably died): it must be released with {@link #releaseStaleLeases()} so another
+     * process can claim the range again.
+     *
+     * Note: the machines must have synchronized clocks.
+     *
+     * @author Marc Plouhinec
+     */
+    class FrameRangeLeases {
+        public:
+            enum class RangeStatus { PENDING, LEASED, STALE, DONE };
+
+            struct FrameRange {
+                int firstFrameIndex = 0;
+                int endFrameIndex = 0; // Exclusive
+            };
+
+        private:
+            const boost::filesystem::path folderPath;
+            const int nbFrames;
+            const int rangeSize;
+            const int leaseTimeoutInSeconds;
+            const std::string ownerId;
+
+        public:
+            FrameRangeLeases(
+                const boost::filesystem::path& folderPath,
+                int nbFrames,
+                int rangeSize,
+                int leaseTimeoutInSeconds);
+
+            std::vector<FrameRange> getFrameRanges() const;
+
+            RangeStatus getStatus(const FrameRange& frameRange) const;
+
+            /**
+             * Claim the given frame range.
+             *
+             * @return false if the range is already leased by another process.
+             */
+            bool tryAcquire(const FrameRange& frameRange) const;
+
+            /**
+             * Tell the other processes that the current one is still working on the given range.
+             *
+             * @return false if the lease is not owned by the current process anymore (it was released as
+             *         stale, and maybe claimed by another process), or if it could not be touched.
+             */
+            bool renew(const FrameRange& frameRange) const;
+
+            /**
+             * Mark the given range as done and release its lease (if it is still owned by the current process).
+             */
+            void complete(const FrameRange& frameRange) const;
+
+            /**
+             * Release the lease of the given range without marking it as done (if it is still owned by the
+             * current process).
+             */
+            void release(const FrameRange& frameRange) const;
+
+            /**
+             * Delete stale leases, so their frame ranges can be claimed by other processes.
+             *
+             * @return The number of released leases.
+             */
+            int releaseStaleLeases() const;
+
+            /**
+             * @return A summary of the progress, for example "12/50 ranges done (240/1000 frames), 4 leased, 1 stale".
+             */
+            std::string describeProgress() const;
+
+            int getLeaseTimeoutInSeconds() const {
+                return leaseTimeoutInSeconds;
+            }
+
+        private:
+            bool isLeaseOwned(const FrameRange& frameRange) const;
+
+            boost::filesystem::path getLeasePath(const FrameRange& frameRange) const;
+            boost::filesystem::path getDonePath(const FrameRange& frameRange) const;
+    };
+
+}
+
+#endif // UTILS_FRAME_RANGE_LEASES
@@ -0,0 +1,179 @@
+#include <cstring>
+#include <stdexcept>
+#include "JpegArchive.hpp"
+
+using namespace utils;
+using std::ifstream;
+using std::ofstream;
+using std::runtime_error;
+using std::string;
+using std::to_string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+const string JpegArchive::FILE_EXTENSION = ".jpgarc";
+const char JpegArchive::HEADER_MAGIC[8] = { 'C', 'T', 'J', 'P', 'G', 'A', 'R', 'C' };
+const char JpegArchive::FOOTER_MAGIC[8] = { 'C', 'T', 'J', 'P', 'G', 'E', 'N', 'D' };
+
+static void writeLittleEndian(ofstream& outputStream, uint64_t value, int nbBytes) {
+    for (int i = 0; i < nbBytes; i++) {
+        outputStream.put((char) ((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static uint64_t readLittleEndian(const unsigned char* bytes, int nbBytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < nbBytes; i++) {
+        value |= ((uint64_t) bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+JpegArchiveWriter::~JpegArchiveWriter() {
+    if (isOpen()) {
+        try {
+            close();
+        } catch (const std::exception& e) {
+            // Nothing more can be done in a destructor: the owner must call close() to get the errors
+        }
+    }
+}
+
+void JpegArchiveWriter::open(const string& path) {
+    archivePath = path;
+    entries.clear();
+
+    outputStream.open(path, std::ios::binary | std::ios::trunc);
+    if (!outputStream.is_open()) {
+        throw runtime_error("Unable to create the file: " + path);
+    }
+
+    outputStream.write(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+    writeLittleEndian(outputStream, FORMAT_VERSION, 4);
+}
+
+void JpegArchiveWriter::append(int frameIndex, const vector<unsigned char>& jpegData) {
+    Entry entry;
+    entry.frameIndex = frameIndex;
+    entry.offset = outputStream.tellp();
+    entry.size = jpegData.size();
+
+    outputStream.write(reinterpret_cast<const char*>(jpegData.data()), jpegData.size());
+    if (!outputStream) {
+        throw runtime_error("Unable to write into the file: " + archivePath);
+    }
+    entries.push_back(entry);
+}
+
+void JpegArchiveWriter::close() {
+    uint64_t tableOffset = outputStream.tellp();
+    for (const Entry& entry : entries) {
+        writeLittleEndian(outputStream, (uint32_t) entry.frameIndex, 4);
+        writeLittleEndian(outputStream, entry.offset, 8);
+        writeLittleEndian(outputStream, entry.size, 4);
+    }
+
+    writeLittleEndian(outputStream, tableOffset, 8);
+    writeLittleEndian(outputStream, entries.size(), 4);
+    outputStream.write(FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+
+    outputStream.close();
+    if (outputStream.fail()) {
+        throw runtime_error("Unable to write into the file: " + archivePath);
+    }
+}
+
+JpegArchiveReader::JpegArchiveReader(const string& path) : archivePath(path) {
+    inputStream.open(path, std::ios::binary);
+    if (!inputStream.is_open()) {
+        throw runtime_error("Unable to open the file: " + path);
+    }
+
+    // Check the header
+    char header[HEADER_SIZE];
+    if (!inputStream.read(header, HEADER_SIZE) || memcmp(header, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0) {
+        throw runtime_error("Not a JPEG archive: " + path);
+    }
+    uint32_t version = readLittleEndian(reinterpret_cast<unsigned char*>(header + 8), 4);
+    if (version != FORMAT_VERSION) {
+        throw runtime_error("Unsupported JPEG archive version (" + to_string(version) + "): " + path);
+    }
+
+    // Read the footer
+    unsigned char footer[FOOTER_SIZE];
+    inputStream.seekg(-FOOTER_SIZE, std::ios::end);
+    if (!inputStream.read(reinterpret_cast<char*>(footer), FOOTER_SIZE)
+        || memcmp(footer + 12, FOOTER_MAGIC, sizeof(FOOTER_MAGIC)) != 0) {
+        throw runtime_error("Incomplete JPEG archive (was the writer interrupted?): " + path);
+    }
+    uint64_t tableOffset = readLittleEndian(footer, 8);
+    uint32_t nbEntries = readLittleEndian(footer + 8, 4);
+
+    // Read the offset table
+    vector<unsigned char> table((size_t) nbEntries * ENTRY_SIZE);
+    inputStream.seekg(tableOffset);
+    if (!inputStream.read(reinterpret_cast<char*>(table.data()), table.size())) {
+        throw runtime_error("Unable to read the offset table of the JPEG archive: " + path);
+    }
+    for (uint32_t i = 0; i < nbEntries; i++) {
+        const unsigned char* entryBytes = table.data() + i * ENTRY_SIZE;
+        Entry entry;
+        entry.frameIndex = (int32_t) readLittleEndian(entryBytes, 4);
+        entry.offset = readLittleEndian(entryBytes + 4, 8);
+        entry.size = readLittleEndian(entryBytes + 12, 4);
+        entriesByFrameIndex[entry.frameIndex] = entry;
+    }
+}
+
+vector<int> JpegArchiveReader::getFrameIndexes() const {
+    vector<int> frameIndexes;
+    for (auto& entryAndFrameIndex : entriesByFrameIndex) {
+        frameIndexes.push_back(entryAndFrameIndex.first);
+    }
+    return frameIndexes;
+}
+
+vector<unsigned char> JpegArchiveReader::readJpegData(int frameIndex) {
+    auto entryIterator = entriesByFrameIndex.find(frameIndex);
+    if (entryIterator == entriesByFrameIndex.end()) {
+        throw std::out_of_range("The frame " + to_string(frameIndex) + " is not in the archive: " + archivePath);
+    }
+
+    const Entry& entry = entryIterator->second;
+    vector<unsigned char> jpegData(entry.size);
+    inputStream.clear();
+    inputStream.seekg(entry.offset);
+    if (!inputStream.read(reinterpret_cast<char*>(jpegData.data()), entry.size)) {
+        throw runtime_error("Unable to read the frame " + to_string(frameIndex) + " from: " + archivePath);
+    }
+    return jpegData;
+}
+
+cv::Mat JpegArchiveReader::readFrame(int frameIndex) {
+    return cv::imdecode(readJpegData(frameIndex), cv::IMREAD_COLOR);
+}
+
+int JpegArchiveReader::extractFrames(const fs::path& outputFolderPath, int firstFrameIndex, int lastFrameIndex) {
+    if (!fs::is_directory(outputFolderPath)) {
+        fs::create_directories(outputFolderPath);
+    }
+
+    int nbExtractedFrames = 0;
+    for (auto& entryAndFrameIndex : entriesByFrameIndex) {
+        int frameIndex = entryAndFrameIndex.first;
+        if (frameIndex < firstFrameIndex || frameIndex > lastFrameIndex) {
+            continue;
+        }
+
+        vector<unsigned char> jpegData = readJpegData(frameIndex);
+        fs::path imagePath(outputFolderPath / (to_string(frameIndex) + ".jpg"));
+        ofstream imageStream(imagePath.string(), std::ios::binary | std::ios::trunc);
+        imageStream.write(reinterpret_cast<const char*>(jpegData.data()), jpegData.size());
+        imageStream.close();
+        if (imageStream.fail()) {
+            throw runtime_error("Unable to write the file: " + imagePath.string());
+        }
+        nbExtractedFrames++;
+    }
+    return nbExtractedFrames;
+}
@@ -0,0 +1,99 @@
+#ifndef UTILS_JPEG_ARCHIVE
+#define UTILS_JPEG_ARCHIVE
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <opencv2/opencv.hpp>
+
+namespace utils {
+
+    /**
+     * A JPEG archive is a single file containing many JPEG images, one per video frame:
+     * - a header: the "CTJPGARC" magic string and a format version (uint32),
+     * - the JPEG images, one after the other,
+     * - an offset table: for each image, its frame index (int32), offset (uint64) and size (uint32),
+     * - a footer: the offset of the table (uint64), the number of images (uint32) and the
+     *   "CTJPGEND" magic string.
+     *
+     * All the integers are little-endian.
+     *
+     * @author Marc Plouhinec
+     */
+    class JpegArchive {
+        public:
+            static const std::string FILE_EXTENSION;
+
+        protected:
+            struct Entry {
+                int32_t frameIndex;
+                uint64_t offset;
+                uint32_t size;
+            };
+
+            static const char HEADER_MAGIC[8];
+            static const char FOOTER_MAGIC[8];
+            static const uint32_t FORMAT_VERSION = 1;
+            static const int HEADER_SIZE = 12;
+            static const int ENTRY_SIZE = 16;
+            static const int FOOTER_SIZE = 20;
+    };
+
+    class JpegArchiveWriter : public JpegArchive {
+        private:
+            std::ofstream outputStream;
+            std::string archivePath;
+            std::vector<Entry> entries;
+
+        public:
+            JpegArchiveWriter() {}
+
+            ~JpegArchiveWriter();
+
+            void open(const std::string& path);
+
+            void append(int frameIndex, const std::vector<unsigned char>& jpegData);
+
+            /**
+             * Write the offset table and the footer, then close the file.
+             */
+            void close();
+
+            bool isOpen() const {
+                return outputStream.is_open();
+            }
+    };
+
+    class JpegArchiveReader : public JpegArchive {
+        private:
+            std::ifstream inputStream;
+            std::string archivePath;
+            std::map<int, Entry> entriesByFrameIndex;
+
+        public:
+            explicit JpegArchiveReader(const std::string& path);
+
+            std::vector<int> getFrameIndexes() const;
+
+            std::vector<unsigned char> readJpegData(int frameIndex);
+
+            cv::Mat readFrame(int frameIndex);
+
+            /**
+             * Write the frames between firstFrameIndex and lastFrameIndex (included) into separate
+             * "<frameIndex>.jpg" files, without re-encoding them.
+             *
+             * @return Number of extracted frames.
+             */
+            int extractFrames(
+                const boost::filesystem::path& outputFolderPath,
+                int firstFrameIndex,
+                int lastFrameIndex);
+    };
+
+}
+
+#endif // UTILS_JPEG_ARCHIVE
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "AtomicFileWriter.hpp"
+#include "KeyframeIndex.hpp"
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+using namespace utils;
+using std::ifstream;
+using std::runtime_error;
+using std::string;
+using std::stringstream;
+using std::to_string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+static const string INDEX_FILE_HEADER = "keyframe-index-v1";
+
+KeyframeIndex KeyframeIndex::loadOrBuild(const fs::path& videoPath, const fs::path& indexPath) {
+    string videoSignature = buildVideoSignature(videoPath);
+
+    // Load the existing index if it matches the video
+    ifstream indexFile(indexPath.string());
+    if (indexFile) {
+        string header;
+        string signature;
+        std::getline(indexFile, header);
+        std::getline(indexFile, signature);
+        if (header == INDEX_FILE_HEADER && signature == videoSignature) {
+            KeyframeIndex keyframeIndex;
+            int keyframeFrameIndex;
+            while (indexFile >> keyframeFrameIndex) {
+                keyframeIndex.keyframeIndexes.push_back(keyframeFrameIndex);
+            }
+            return keyframeIndex;
+        }
+    }
+    indexFile.close();
+
+    // Build the index and save it
+    KeyframeIndex keyframeIndex = build(videoPath);
+
+    stringstream content;
+    content << INDEX_FILE_HEADER << "\n" << videoSignature << "\n";
+    for (int keyframeFrameIndex : keyframeIndex.keyframeIndexes) {
+        content << keyframeFrameIndex << "\n";
+    }
+    boost::system::error_code errorCode;
+    fs::create_directories(indexPath.parent_path(), errorCode);
+    AtomicFileWriter::write(indexPath, content.str());
+
+    return keyframeIndex;
+}
+
+int KeyframeIndex::findKeyframeAtOrBefore(int frameIndex) const {
+    auto nextKeyframeIt = std::upper_bound(keyframeIndexes.begin(), keyframeIndexes.end(), frameIndex);
+    if (nextKeyframeIt == keyframeIndexes.begin()) {
+        return 0;
+    }
+    return *(nextKeyframeIt - 1);
+}
+
+KeyframeIndex KeyframeIndex::build(const fs::path& videoPath) {
+    AVFormatContext* pFormatContext = nullptr;
+    if (avformat_open_input(&pFormatContext, videoPath.string().c_str(), nullptr, nullptr) != 0) {
+        throw runtime_error("Unable to open the video: " + videoPath.string());
+    }
+    if (avformat_find_stream_info(pFormatContext, nullptr) < 0) {
+        avformat_close_input(&pFormatContext);
+        throw runtime_error("Unable to read the streams of the video: " + videoPath.string());
+    }
+    int videoStreamIndex = av_find_best_stream(pFormatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (videoStreamIndex < 0) {
+        avformat_close_input(&pFormatContext);
+        throw runtime_error("No video stream found in: " + videoPath.string());
+    }
+
+    // Read the timestamps of all the packets, without decoding them
+    vector<int64_t> timestamps;
+    vector<int64_t> keyframeTimestamps;
+    AVPacket* pPacket = av_packet_alloc();
+    while (av_read_frame(pFormatContext, pPacket) >= 0) {
+        if (pPacket->stream_index == videoStreamIndex) {
+            int64_t timestamp = pPacket->pts != AV_NOPTS_VALUE ? pPacket->pts : pPacket->dts;
+            timestamps.push_back(timestamp);
+            if (pPacket->flags & AV_PKT_FLAG_KEY) {
+                keyframeTimestamps.push_back(timestamp);
+            }
+        }
+        av_packet_unref(pPacket);
+    }
+    av_packet_free(&pPacket);
+    avformat_close_input(&pFormatContext);
+
+    // Packets are in decoding order: the frame index of a keyframe is its position in presentation order
+    std::sort(timestamps.begin(), timestamps.end());
+    KeyframeIndex keyframeIndex;
+    for (int64_t keyframeTimestamp : keyframeTimestamps) {
+        auto timestampIt = std::lower_bound(timestamps.begin(), timestamps.end(), keyframeTimestamp);
+        keyframeIndex.keyframeIndexes.push_back(timestampIt - timestamps.begin());
+    }
+    std::sort(keyframeIndex.keyframeIndexes.begin(), keyframeIndex.keyframeIndexes.end());
+    return keyframeIndex;
+}
+
+string KeyframeIndex::buildVideoSignature(const fs::path& videoPath) {
+    return videoPath.filename().string()
+        + " " + to_string(fs::file_size(videoPath))
+        + " " + to_string(fs::last_write_time(videoPath));
+}
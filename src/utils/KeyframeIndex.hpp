@@ -0,0 +1,49 @@
+#ifndef UTILS_KEYFRAME_INDEX
+#define UTILS_KEYFRAME_INDEX
+
+#include <vector>
+#include <boost/filesystem.hpp>
+
+namespace utils {
+
+    /**
+     * Position of the keyframes of a video, in presentation order. Seeking exactly is only possible
+     * on a keyframe: in order to read any frame, a video reader seeks to the keyframe before it
+     * and decodes forward.
+     *
+     * The index is built once by reading the video packets with FFmpeg (without decoding them), then
+     * saved in a file. It is rebuilt when the video file changes.
+     *
+     * @author Marc Plouhinec
+     */
+    class KeyframeIndex {
+        private:
+            std::vector<int> keyframeIndexes;
+
+        public:
+            KeyframeIndex() {}
+
+            /**
+             * Load the index from the given file, or build it from the video and save it in this file
+             * if it doesn't exist or is outdated.
+             */
+            static KeyframeIndex loadOrBuild(
+                const boost::filesystem::path& videoPath, const boost::filesystem::path& indexPath);
+
+            /**
+             * @return The index of the last keyframe before or at the given frame (0 if unknown).
+             */
+            int findKeyframeAtOrBefore(int frameIndex) const;
+
+            int getNbKeyframes() const {
+                return keyframeIndexes.size();
+            }
+
+        private:
+            static KeyframeIndex build(const boost::filesystem::path& videoPath);
+            static std::string buildVideoSignature(const boost::filesystem::path& videoPath);
+    };
+
+}
+
+#endif // UTILS_KEYFRAME_INDEX
@@ -0,0 +1,46 @@
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MemoryMappedFile.hpp"
+
+using namespace utils;
+using std::runtime_error;
+namespace fs = boost::filesystem;
+
+MemoryMappedFile::MemoryMappedFile(const fs::path& path) {
+    int fileDescriptor = open(path.string().c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        throw runtime_error("Unable to open the file: " + path.string());
+    }
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0) {
+        close(fileDescriptor);
+        throw runtime_error("Unable to read the size of the file: " + path.string());
+    }
+    dataSize = fileStatus.st_size;
+    if (dataSize == 0) {
+        close(fileDescriptor);
+        return;
+    }
+
+    void* pMapping = mmap(nullptr, dataSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor); // Note: the mapping stays valid after the file is closed
+    if (pMapping == MAP_FAILED) {
+        throw runtime_error("Unable to map the file in memory: " + path.string());
+    }
+
+    // The file is read from start to end. Note: the advice values are not flags, so each one needs its own
+    // call. They are only hints, the file can still be read if the kernel rejects them.
+    isAccessAdviceApplied = madvise(pMapping, dataSize, MADV_SEQUENTIAL) == 0;
+    isAccessAdviceApplied = madvise(pMapping, dataSize, MADV_WILLNEED) == 0 && isAccessAdviceApplied;
+    pData = static_cast<const char*>(pMapping);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (pData) {
+        munmap(const_cast<char*>(pData), dataSize);
+    }
+}
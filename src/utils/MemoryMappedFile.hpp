@@ -0,0 +1,48 @@
+#ifndef UTILS_MEMORY_MAPPED_FILE
+#define UTILS_MEMORY_MAPPED_FILE
+
+#include <cstddef>
+#include <boost/filesystem.hpp>
+
+namespace utils {
+
+    /**
+     * Read-only view of a whole file mapped in memory. The pages come from the page cache of the operating
+     * system, so they are shared by all the processes that map the same file, and are only read from the
+     * disk once. The file is unmapped when this object is destroyed.
+     *
+     * @author Marc Plouhinec
+     */
+    class MemoryMappedFile {
+        private:
+            const char* pData = nullptr;
+            size_t dataSize = 0;
+            bool isAccessAdviceApplied = false;
+
+        public:
+            MemoryMappedFile(const boost::filesystem::path& path);
+
+            MemoryMappedFile(const MemoryMappedFile&) = delete;
+            MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+            virtual ~MemoryMappedFile();
+
+            const char* data() const {
+                return pData;
+            }
+
+            size_t size() const {
+                return dataSize;
+            }
+
+            /**
+             * @return true if the kernel accepted the sequential read-ahead advice for the mapping.
+             */
+            bool isReadAheadAdvised() const {
+                return isAccessAdviceApplied;
+            }
+    };
+
+}
+
+#endif // UTILS_MEMORY_MAPPED_FILE
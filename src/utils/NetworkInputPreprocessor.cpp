@@ -0,0 +1,31 @@
+#include "NetworkInputPreprocessor.hpp"
+#include "BgrToPlanarConverter.hpp"
+
+using namespace utils;
+using std::vector;
+
+void NetworkInputPreprocessor::preprocess(const cv::Mat& frame, float* pOutput) {
+    if (frame.size() == inputSize) {
+        BgrToPlanarConverter::convert(frame, pOutput, scale);
+        return;
+    }
+
+    // Note: resizedFrame is only allocated during the first call
+    cv::resize(frame, resizedFrame, inputSize, 0, 0, cv::INTER_LINEAR);
+    BgrToPlanarConverter::convert(resizedFrame, pOutput, scale);
+}
+
+const cv::Mat& NetworkInputPreprocessor::preprocess(const vector<cv::Mat>& frames) {
+    int nbFrames = frames.size();
+    int tensorSizes[] = { nbFrames, 3, inputSize.height, inputSize.width };
+
+    // Note: the tensor is only reallocated when the number of frames changes
+    tensor.create(4, tensorSizes, CV_32F);
+
+    size_t frameTensorSize = (size_t) 3 * inputSize.width * inputSize.height;
+    float* pTensor = tensor.ptr<float>();
+    for (int frameOffset = 0; frameOffset < nbFrames; frameOffset++) {
+        preprocess(frames[frameOffset], pTensor + frameOffset * frameTensorSize);
+    }
+    return tensor;
+}
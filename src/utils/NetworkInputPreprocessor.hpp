@@ -0,0 +1,59 @@
+#ifndef UTILS_NETWORK_INPUT_PREPROCESSOR
+#define UTILS_NETWORK_INPUT_PREPROCESSOR
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace utils {
+
+    /**
+     * Convert video frames into the input tensor of a neural network (NCHW layout, planar RGB floats).
+     *
+     * Frames are first resized to the network input size while they are still 8-bit BGR images (the
+     * resize reads the cropped region of interest directly, so non-continuous frames are not copied),
+     * then converted into normalized planar floats in one pass, directly into the tensor. The tensor and
+     * the intermediate resized image are allocated once and reused.
+     *
+     * Note: an instance must not be shared by several threads.
+     *
+     * @author Marc Plouhinec
+     */
+    class NetworkInputPreprocessor {
+        private:
+            cv::Size inputSize;
+            float scale;
+            cv::Mat resizedFrame;
+            cv::Mat tensor;
+
+        public:
+            /**
+             * @param inputSize Width and height of the network input.
+             * @param scale Factor applied to each pixel value (for example 1 / 255.0).
+             */
+            NetworkInputPreprocessor(cv::Size inputSize, float scale) : inputSize(inputSize), scale(scale) {}
+
+            virtual ~NetworkInputPreprocessor() {}
+
+            /**
+             * Convert one frame into the given buffer.
+             *
+             * @param frame 8-bit BGR image of any size.
+             * @param pOutput Buffer of at least 3 * inputSize.width * inputSize.height floats.
+             */
+            void preprocess(const cv::Mat& frame, float* pOutput);
+
+            /**
+             * Convert frames into a 4D tensor of dimensions (nbFrames, 3, inputSize.height, inputSize.width).
+             *
+             * @return Reused tensor, only valid until the next call.
+             */
+            const cv::Mat& preprocess(const std::vector<cv::Mat>& frames);
+
+            cv::Size getInputSize() const {
+                return inputSize;
+            }
+    };
+
+}
+
+#endif // UTILS_NETWORK_INPUT_PREPROCESSOR
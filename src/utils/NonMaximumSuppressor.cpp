@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "NonMaximumSuppressor.hpp"
+
+using namespace model;
+using namespace utils;
+using std::vector;
+
+namespace {
+
+    struct Box {
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+        float area;
+        DetectedObjectType objectType;
+    };
+
+}
+
+vector<DetectedObject> NonMaximumSuppressor::suppress(const vector<DetectedObject>& detectedObjects) const {
+    int nbObjects = detectedObjects.size();
+    if (nbObjects <= 1) {
+        return detectedObjects;
+    }
+
+    // Sort the objects by decreasing confidence
+    vector<int> sortedIndexes(nbObjects);
+    std::iota(sortedIndexes.begin(), sortedIndexes.end(), 0);
+    std::stable_sort(sortedIndexes.begin(), sortedIndexes.end(), [&](int index1, int index2) {
+        return detectedObjects[index1].confidence > detectedObjects[index2].confidence;
+    });
+
+    // Convert the objects into boxes and find the area covered by them
+    vector<Box> boxes(nbObjects);
+    float minX = detectedObjects[0].x;
+    float minY = detectedObjects[0].y;
+    float maxX = minX;
+    float maxY = minY;
+    float totalWidth = 0;
+    float totalHeight = 0;
+    for (int i = 0; i < nbObjects; i++) {
+        const DetectedObject& detectedObject = detectedObjects[i];
+        Box& box = boxes[i];
+        box.x1 = detectedObject.x;
+        box.y1 = detectedObject.y;
+        box.x2 = detectedObject.x + detectedObject.width;
+        box.y2 = detectedObject.y + detectedObject.height;
+        box.area = (float) detectedObject.width * (float) detectedObject.height;
+        box.objectType = detectedObject.objectType;
+        minX = std::min(minX, box.x1);
+        minY = std::min(minY, box.y1);
+        maxX = std::max(maxX, box.x2);
+        maxY = std::max(maxY, box.y2);
+        totalWidth += detectedObject.width;
+        totalHeight += detectedObject.height;
+    }
+
+    // Build a grid with cells of about the average object size (at most 64 x 64 cells)
+    float cellWidth = std::max({ totalWidth / nbObjects, (maxX - minX) / 64, 1.0f });
+    float cellHeight = std::max({ totalHeight / nbObjects, (maxY - minY) / 64, 1.0f });
+    int nbColumns = (int) ((maxX - minX) / cellWidth) + 1;
+    int nbRows = (int) ((maxY - minY) / cellHeight) + 1;
+    vector<vector<int>> keptIndexesByCell(nbColumns * nbRows);
+
+    vector<DetectedObject> keptObjects;
+    for (int index : sortedIndexes) {
+        const Box& box = boxes[index];
+        int firstColumn = std::min(nbColumns - 1, std::max(0, (int) ((box.x1 - minX) / cellWidth)));
+        int lastColumn = std::min(nbColumns - 1, std::max(0, (int) ((box.x2 - minX) / cellWidth)));
+        int firstRow = std::min(nbRows - 1, std::max(0, (int) ((box.y1 - minY) / cellHeight)));
+        int lastRow = std::min(nbRows - 1, std::max(0, (int) ((box.y2 - minY) / cellHeight)));
+
+        // Compare the box with the kept boxes that share a cell with it
+        bool suppressed = false;
+        for (int row = firstRow; row <= lastRow && !suppressed; row++) {
+            for (int column = firstColumn; column <= lastColumn && !suppressed; column++) {
+                for (int keptIndex : keptIndexesByCell[row * nbColumns + column]) {
+                    const Box& keptBox = boxes[keptIndex];
+                    if (keptBox.objectType != box.objectType) {
+                        continue;
+                    }
+                    float intersectionWidth = std::min(box.x2, keptBox.x2) - std::max(box.x1, keptBox.x1);
+                    float intersectionHeight = std::min(box.y2, keptBox.y2) - std::max(box.y1, keptBox.y1);
+                    if (intersectionWidth <= 0 || intersectionHeight <= 0) {
+                        continue;
+                    }
+                    float intersection = intersectionWidth * intersectionHeight;
+                    float iou = intersection / (box.area + keptBox.area - intersection);
+                    if (iou > iouThreshold) {
+                        suppressed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!suppressed) {
+            keptObjects.push_back(detectedObjects[index]);
+            for (int row = firstRow; row <= lastRow; row++) {
+                for (int column = firstColumn; column <= lastColumn; column++) {
+                    keptIndexesByCell[row * nbColumns + column].push_back(index);
+                }
+            }
+        }
+    }
+
+    return keptObjects;
+}
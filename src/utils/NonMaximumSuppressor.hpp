@@ -0,0 +1,39 @@
+#ifndef UTILS_NON_MAXIMUM_SUPPRESSOR
+#define UTILS_NON_MAXIMUM_SUPPRESSOR
+
+#include <vector>
+#include "../model/detection/DetectedObject.hpp"
+
+namespace utils {
+
+    /**
+     * Remove duplicated detections: when two objects of the same type overlap with an intersection over
+     * union higher than a threshold, only the one with the highest confidence is kept.
+     *
+     * Objects are sorted once by decreasing confidence, then each one is only compared with the kept
+     * objects located in the same cells of a grid, instead of all the kept objects.
+     *
+     * @author Marc Plouhinec
+     */
+    class NonMaximumSuppressor {
+        private:
+            float iouThreshold;
+
+        public:
+            /**
+             * @param iouThreshold Objects overlapping with an intersection over union higher than this value
+             *                     are considered as duplicates.
+             */
+            NonMaximumSuppressor(float iouThreshold) : iouThreshold(iouThreshold) {}
+
+            virtual ~NonMaximumSuppressor() {}
+
+            /**
+             * @return The kept objects, sorted by decreasing confidence.
+             */
+            std::vector<model::DetectedObject> suppress(const std::vector<model::DetectedObject>& detectedObjects) const;
+    };
+
+}
+
+#endif // UTILS_NON_MAXIMUM_SUPPRESSOR
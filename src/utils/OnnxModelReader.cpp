@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "OnnxModelReader.hpp"
+
+using namespace utils;
+using std::runtime_error;
+using std::string;
+using std::vector;
+
+namespace {
+
+    // Protobuf wire types
+    const int WIRE_TYPE_VARINT = 0;
+    const int WIRE_TYPE_64_BIT = 1;
+    const int WIRE_TYPE_LENGTH_DELIMITED = 2;
+    const int WIRE_TYPE_32_BIT = 5;
+
+    // Field numbers defined in onnx.proto
+    const int MODEL_PROTO_GRAPH = 7;
+    const int GRAPH_PROTO_INITIALIZER = 5;
+    const int GRAPH_PROTO_INPUT = 11;
+    const int TENSOR_PROTO_NAME = 8;
+    const int VALUE_INFO_PROTO_NAME = 1;
+    const int VALUE_INFO_PROTO_TYPE = 2;
+    const int TYPE_PROTO_TENSOR_TYPE = 1;
+    const int TENSOR_TYPE_SHAPE = 2;
+    const int TENSOR_SHAPE_PROTO_DIM = 1;
+    const int DIMENSION_DIM_VALUE = 1;
+
+    /**
+     * Iterate on the fields of a protobuf message.
+     */
+    class ProtobufMessageReader {
+        private:
+            const char* pPosition;
+            const char* pEnd;
+
+            uint64_t readVarint() {
+                uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    if (pPosition >= pEnd) {
+                        throw runtime_error("Invalid ONNX model: truncated varint.");
+                    }
+                    uint8_t byte = *pPosition++;
+                    value |= (uint64_t) (byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0) {
+                        return value;
+                    }
+                }
+                throw runtime_error("Invalid ONNX model: varint too long.");
+            }
+
+            void skip(uint64_t nbBytes) {
+                if (nbBytes > (uint64_t) (pEnd - pPosition)) {
+                    throw runtime_error("Invalid ONNX model: truncated field.");
+                }
+                pPosition += nbBytes;
+            }
+
+        public:
+            int fieldNumber = 0;
+            int wireType = 0;
+            uint64_t varintValue = 0;
+            const char* pFieldData = nullptr;
+            size_t fieldSize = 0;
+
+            ProtobufMessageReader(const char* pData, size_t size) : pPosition(pData), pEnd(pData + size) {}
+
+            /**
+             * Read the next field.
+             *
+             * @return false at the end of the message.
+             */
+            bool next() {
+                if (pPosition >= pEnd) {
+                    return false;
+                }
+                uint64_t key = readVarint();
+                fieldNumber = key >> 3;
+                wireType = key & 0x7;
+                switch (wireType) {
+                    case WIRE_TYPE_VARINT:
+                        varintValue = readVarint();
+                        break;
+                    case WIRE_TYPE_64_BIT:
+                        skip(8);
+                        break;
+                    case WIRE_TYPE_LENGTH_DELIMITED:
+                        fieldSize = readVarint();
+                        pFieldData = pPosition;
+                        skip(fieldSize);
+                        break;
+                    case WIRE_TYPE_32_BIT:
+                        skip(4);
+                        break;
+                    default:
+                        throw runtime_error("Invalid ONNX model: unsupported wire type " + std::to_string(wireType));
+                }
+                return true;
+            }
+
+            bool isMessage(int expectedFieldNumber) const {
+                return fieldNumber == expectedFieldNumber && wireType == WIRE_TYPE_LENGTH_DELIMITED;
+            }
+
+            ProtobufMessageReader subMessage() const {
+                return ProtobufMessageReader(pFieldData, fieldSize);
+            }
+
+            string stringValue() const {
+                return string(pFieldData, fieldSize);
+            }
+    };
+
+    /**
+     * Find the first sub-message with the given field number.
+     */
+    bool findMessage(ProtobufMessageReader& message, int fieldNumber, ProtobufMessageReader& subMessage) {
+        while (message.next()) {
+            if (message.isMessage(fieldNumber)) {
+                subMessage = message.subMessage();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    vector<int64_t> readValueInfoShape(ProtobufMessageReader valueInfo) {
+        ProtobufMessageReader typeProto(nullptr, 0);
+        ProtobufMessageReader tensorType(nullptr, 0);
+        ProtobufMessageReader tensorShape(nullptr, 0);
+        vector<int64_t> shape;
+        if (!findMessage(valueInfo, VALUE_INFO_PROTO_TYPE, typeProto)
+            || !findMessage(typeProto, TYPE_PROTO_TENSOR_TYPE, tensorType)
+            || !findMessage(tensorType, TENSOR_TYPE_SHAPE, tensorShape)) {
+            return shape;
+        }
+
+        while (tensorShape.next()) {
+            if (!tensorShape.isMessage(TENSOR_SHAPE_PROTO_DIM)) {
+                continue;
+            }
+
+            // A dimension is either a value or a symbolic name (dim_param) for a dynamic dimension
+            int64_t dimensionValue = -1;
+            ProtobufMessageReader dimension = tensorShape.subMessage();
+            while (dimension.next()) {
+                if (dimension.fieldNumber == DIMENSION_DIM_VALUE && dimension.wireType == WIRE_TYPE_VARINT) {
+                    dimensionValue = (int64_t) dimension.varintValue;
+                }
+            }
+            shape.push_back(dimensionValue > 0 ? dimensionValue : -1);
+        }
+        return shape;
+    }
+
+}
+
+vector<int64_t> OnnxModelReader::readInputShape(const char* pData, size_t size) {
+    ProtobufMessageReader model(pData, size);
+    ProtobufMessageReader graph(nullptr, 0);
+    if (!findMessage(model, MODEL_PROTO_GRAPH, graph)) {
+        throw runtime_error("Invalid ONNX model: no graph found.");
+    }
+
+    // The fields can be in any order, so the initializer names are collected before choosing the input
+    vector<string> initializerNames;
+    vector<ProtobufMessageReader> inputs;
+    while (graph.next()) {
+        if (graph.isMessage(GRAPH_PROTO_INITIALIZER)) {
+            ProtobufMessageReader initializer = graph.subMessage();
+            while (initializer.next()) {
+                if (initializer.isMessage(TENSOR_PROTO_NAME)) {
+                    initializerNames.push_back(initializer.stringValue());
+                }
+            }
+        } else if (graph.isMessage(GRAPH_PROTO_INPUT)) {
+            inputs.push_back(graph.subMessage());
+        }
+    }
+
+    for (const ProtobufMessageReader& input : inputs) {
+        string inputName;
+        ProtobufMessageReader inputFields = input;
+        while (inputFields.next()) {
+            if (inputFields.isMessage(VALUE_INFO_PROTO_NAME)) {
+                inputName = inputFields.stringValue();
+            }
+        }
+        if (std::find(initializerNames.begin(), initializerNames.end(), inputName) == initializerNames.end()) {
+            return readValueInfoShape(input);
+        }
+    }
+    throw runtime_error("Invalid ONNX model: the graph has no input.");
+}
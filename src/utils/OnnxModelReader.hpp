@@ -0,0 +1,34 @@
+#ifndef UTILS_ONNX_MODEL_READER
+#define UTILS_ONNX_MODEL_READER
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+    /**
+     * Read information from an ONNX model (protobuf file) without loading it.
+     *
+     * Only the few messages needed to find the graph inputs are decoded, and the other fields (including
+     * the weights) are skipped, so the model can be read directly from a memory-mapped file.
+     *
+     * @author Marc Plouhinec
+     */
+    class OnnxModelReader {
+        public:
+            /**
+             * Read the shape of the first input of the graph (the initializers that are also declared as
+             * inputs by old exporters are ignored).
+             *
+             * @param pData Content of the .onnx file.
+             * @param size Size of the content in bytes.
+             * @return Dimensions of the input tensor (e.g. [1, 3, 416, 416] for NCHW images), with -1 for the
+             *         dynamic dimensions (e.g. a batch size decided at runtime).
+             */
+            static std::vector<int64_t> readInputShape(const char* pData, size_t size);
+    };
+
+}
+
+#endif // UTILS_ONNX_MODEL_READER
@@ -0,0 +1,17 @@
+#include <fstream>
+#include <unistd.h>
+#include "ProcessMemory.hpp"
+
+using namespace utils;
+using std::ifstream;
+
+size_t ProcessMemory::getResidentSetSize() {
+    // The second value of /proc/self/statm is the number of resident pages (Linux only)
+    ifstream statmFile("/proc/self/statm");
+    size_t nbTotalPages = 0;
+    size_t nbResidentPages = 0;
+    if (!(statmFile >> nbTotalPages >> nbResidentPages)) {
+        return 0;
+    }
+    return nbResidentPages * sysconf(_SC_PAGESIZE);
+}
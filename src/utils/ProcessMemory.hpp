@@ -0,0 +1,24 @@
+#ifndef UTILS_PROCESS_MEMORY
+#define UTILS_PROCESS_MEMORY
+
+#include <cstddef>
+
+namespace utils {
+
+    /**
+     * Measure the memory used by the current process.
+     *
+     * @author Marc Plouhinec
+     */
+    class ProcessMemory {
+        public:
+            /**
+             * @return Resident set size (physical memory used by the process, including the shared pages)
+             *         in bytes, or 0 if it is not available.
+             */
+            static size_t getResidentSetSize();
+    };
+
+}
+
+#endif // UTILS_PROCESS_MEMORY
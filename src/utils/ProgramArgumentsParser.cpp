@@ -17,7 +17,22 @@ model::ProgramArguments ProgramArgumentsParser::parse(int argc, char* argv[]) co
     programDesc.add_options()
         ("help", "produce help message")
         ("config-path", po::value<string>(), "path to the config.ini file")
-        ("video-path", po::value<string>(), "path to the video file");
+        ("video-path", po::value<string>(), "path to the video file")
+        ("detect-only", "only detect objects in the video in order to fill the cache, with several threads")
+        ("detect-worker", "only detect objects in the video in order to fill the cache, together with other "
+            "worker processes sharing the same cache folder")
+        ("detect-coordinator", "report the progress of the worker processes and release their stale leases")
+        ("calibrate-detector", "measure the speed of the object detector with each backend, target and number of "
+            "threads, and write the fastest settings into detector-calibration.ini (next to config.ini)")
+        ("compare-detectors", "compare the latency and the detections of the object detector with the reference "
+            "\"opencvdnn\" implementation, and write the report into detector-comparison.txt (next to config.ini)")
+        ("start-frame", po::value<int>(), "index of the first frame to process (default: 0)")
+        ("end-frame", po::value<int>(), "index of the last frame to process (default: last frame of the video)")
+        ("extract-archive", po::value<string>(),
+            "path to a .jpgarc file to extract into .jpg files (--config-path and --video-path are then ignored)")
+        ("extract-output", po::value<string>(),
+            "folder where the extracted .jpg files are written (default: next to the archive)")
+        ("extract-frames", po::value<string>(), "frames to extract, e.g. \"100-200\" (default: all)");
     
     po::variables_map varsMap;
     po::store(po::parse_command_line(argc, argv, programDesc), varsMap);
@@ -28,6 +43,10 @@ model::ProgramArguments ProgramArgumentsParser::parse(int argc, char* argv[]) co
         throw runtime_error("Missing arguments.");
     }
 
+    if (varsMap.count("extract-archive")) {
+        return parseExtractionArguments(varsMap);
+    }
+
     fs::path configurationPath;
     if (varsMap.count("config-path")) {
         string relativeConfigurationPath = varsMap["config-path"].as<string>();
@@ -46,5 +65,66 @@ model::ProgramArguments ProgramArgumentsParser::parse(int argc, char* argv[]) co
         throw runtime_error("Missing argument: --video-path");
     }
 
-    return ProgramArguments(configurationPath, videoPath);
+    ProgramArguments programArguments(configurationPath, videoPath);
+    if (varsMap.count("detect-only") + varsMap.count("detect-worker") + varsMap.count("detect-coordinator")
+        + varsMap.count("calibrate-detector") + varsMap.count("compare-detectors") > 1) {
+        cerr << "--detect-only, --detect-worker, --detect-coordinator, --calibrate-detector and --compare-detectors "
+            "cannot be combined.\n";
+        throw runtime_error("Invalid arguments");
+    }
+    if (varsMap.count("start-frame")) {
+        programArguments.startFrameIndex = varsMap["start-frame"].as<int>();
+    }
+    if (varsMap.count("end-frame")) {
+        programArguments.endFrameIndex = varsMap["end-frame"].as<int>();
+    }
+    if ((varsMap.count("start-frame") || varsMap.count("end-frame"))
+        && (varsMap.count("detect-worker") || varsMap.count("detect-coordinator"))) {
+        cerr << "--start-frame and --end-frame are not supported by --detect-worker and --detect-coordinator.\n";
+        throw runtime_error("Invalid arguments");
+    }
+
+    if (varsMap.count("detect-only")) {
+        programArguments.executionMode = ExecutionMode::DETECT_ONLY;
+    } else if (varsMap.count("detect-worker")) {
+        programArguments.executionMode = ExecutionMode::DETECT_WORKER;
+    } else if (varsMap.count("detect-coordinator")) {
+        programArguments.executionMode = ExecutionMode::DETECT_COORDINATOR;
+    } else if (varsMap.count("calibrate-detector")) {
+        programArguments.executionMode = ExecutionMode::CALIBRATE_DETECTOR;
+    } else if (varsMap.count("compare-detectors")) {
+        programArguments.executionMode = ExecutionMode::COMPARE_DETECTORS;
+    }
+    return programArguments;
+}
+
+model::ProgramArguments ProgramArgumentsParser::parseExtractionArguments(const po::variables_map& varsMap) const {
+    ProgramArguments programArguments;
+    programArguments.extractArchivePath = fs::canonical(fs::path(varsMap["extract-archive"].as<string>()));
+
+    if (varsMap.count("extract-output")) {
+        programArguments.extractOutputPath = fs::absolute(fs::path(varsMap["extract-output"].as<string>()));
+    } else {
+        fs::path archivePath = programArguments.extractArchivePath;
+        programArguments.extractOutputPath = archivePath.parent_path() / archivePath.stem();
+    }
+
+    if (varsMap.count("extract-frames")) {
+        string frameRange = varsMap["extract-frames"].as<string>();
+        auto indexOfDash = frameRange.find('-');
+        try {
+            if (indexOfDash == string::npos) {
+                programArguments.extractFirstFrameIndex = std::stoi(frameRange);
+                programArguments.extractLastFrameIndex = programArguments.extractFirstFrameIndex;
+            } else {
+                programArguments.extractFirstFrameIndex = std::stoi(frameRange.substr(0, indexOfDash));
+                programArguments.extractLastFrameIndex = std::stoi(frameRange.substr(indexOfDash + 1));
+            }
+        } catch (std::logic_error& e) {
+            cerr << "Invalid --extract-frames value: " << frameRange << ". See --help for more info.\n";
+            throw runtime_error("Invalid argument: --extract-frames");
+        }
+    }
+
+    return programArguments;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef UTILS_PROGRAM_ARGUMENT_PARSER
 #define UTILS_PROGRAM_ARGUMENT_PARSER
 
+#include <boost/program_options.hpp>
 #include "../model/ProgramArguments.hpp"
 
 namespace utils {
@@ -8,6 +9,10 @@ namespace utils {
     class ProgramArgumentsParser {
         public:
             model::ProgramArguments parse(int argc, char* argv[]) const;
+
+        private:
+            model::ProgramArguments parseExtractionArguments(
+                const boost::program_options::variables_map& varsMap) const;
     };
 
 }
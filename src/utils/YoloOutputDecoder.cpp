@@ -0,0 +1,120 @@
+#include <algorithm>
+#include "YoloOutputDecoder.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace model;
+using namespace utils;
+using std::min;
+using std::vector;
+
+namespace {
+
+    /**
+     * Find the class with the highest confidence (the first one in case of equality).
+     */
+    int findBestClassId(const float* pClassConfidences, int nbClasses) {
+        if (nbClasses <= 0) {
+            return -1;
+        }
+
+        // Find the highest confidence, 4 classes at a time
+        int classId = 0;
+        float bestConfidence = pClassConfidences[0];
+#ifdef __SSE2__
+        if (nbClasses >= 4) {
+            __m128 maxConfidences = _mm_loadu_ps(pClassConfidences);
+            for (classId = 4; classId + 4 <= nbClasses; classId += 4) {
+                maxConfidences = _mm_max_ps(maxConfidences, _mm_loadu_ps(pClassConfidences + classId));
+            }
+            maxConfidences = _mm_max_ps(
+                maxConfidences, _mm_shuffle_ps(maxConfidences, maxConfidences, _MM_SHUFFLE(1, 0, 3, 2)));
+            maxConfidences = _mm_max_ps(
+                maxConfidences, _mm_shuffle_ps(maxConfidences, maxConfidences, _MM_SHUFFLE(2, 3, 0, 1)));
+            bestConfidence = _mm_cvtss_f32(maxConfidences);
+        }
+#endif
+        for (; classId < nbClasses; classId++) {
+            bestConfidence = std::max(bestConfidence, pClassConfidences[classId]);
+        }
+
+        // Return the index of the first class with this confidence
+        return std::find(pClassConfidences, pClassConfidences + nbClasses, bestConfidence) - pClassConfidences;
+    }
+
+}
+
+YoloOutputDecoder::YoloOutputDecoder(
+    const Configuration& configuration,
+    const vector<DetectedObjectType>& objectTypesByClassId) : objectTypesByClassId(objectTypesByClassId) {
+
+    float minTipConfidence = configuration.objectDetectionMinTipConfidence;
+    float minChopstickConfidence = configuration.objectDetectionMinChopstickConfidence;
+    float minArmConfidence = configuration.objectDetectionMinArmConfidence;
+    minConfidence = min(minTipConfidence, min(minChopstickConfidence, minArmConfidence));
+
+    for (DetectedObjectType objectType : objectTypesByClassId) {
+        switch (objectType) {
+            case DetectedObjectType::SMALL_TIP:
+            case DetectedObjectType::BIG_TIP:
+                minConfidencesByClassId.push_back(minTipConfidence);
+                break;
+            case DetectedObjectType::ARM:
+                minConfidencesByClassId.push_back(minArmConfidence);
+                break;
+            case DetectedObjectType::CHOPSTICK:
+            default:
+                minConfidencesByClassId.push_back(minChopstickConfidence);
+                break;
+        }
+    }
+}
+
+void YoloOutputDecoder::decodeRows(
+    const float* pRows, int nbRows, int nbCols, cv::Size frameSize, vector<DetectedObject>& detectedObjects) const {
+
+    int nbClasses = min(nbCols - 5, (int) objectTypesByClassId.size());
+    for (int rowIndex = 0; rowIndex < nbRows; rowIndex++) {
+        const float* pRow = pRows + (size_t) rowIndex * nbCols;
+        decode(pRow[0], pRow[1], pRow[2], pRow[3], pRow[4], pRow + 5, nbClasses, frameSize, detectedObjects);
+    }
+}
+
+bool YoloOutputDecoder::decode(
+    float centerX,
+    float centerY,
+    float width,
+    float height,
+    float objectness,
+    const float* pClassConfidences,
+    int nbClasses,
+    cv::Size frameSize,
+    vector<DetectedObject>& detectedObjects) const {
+
+    // The confidence of each class is the objectness multiplied by the probability of the class
+    if (objectness < minConfidence) {
+        return false;
+    }
+
+    int classId = findBestClassId(pClassConfidences, min(nbClasses, (int) objectTypesByClassId.size()));
+    if (classId < 0) {
+        return false;
+    }
+    float confidence = pClassConfidences[classId];
+    if (confidence < minConfidencesByClassId[classId]) {
+        return false;
+    }
+
+    float frameCenterX = centerX * frameSize.width;
+    float frameCenterY = centerY * frameSize.height;
+    float frameWidth = width * frameSize.width;
+    float frameHeight = height * frameSize.height;
+    detectedObjects.emplace_back(
+        frameCenterX - (frameWidth / 2), frameCenterY - (frameHeight / 2),
+        frameWidth, frameHeight,
+        objectTypesByClassId[classId],
+        confidence);
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef UTILS_YOLO_OUTPUT_DECODER
+#define UTILS_YOLO_OUTPUT_DECODER
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "../model/Configuration.hpp"
+#include "../model/detection/DetectedObject.hpp"
+
+namespace utils {
+
+    /**
+     * Convert the raw detections of a YOLO neural network into {@link DetectedObject}s.
+     *
+     * A detection is made of a bounding box (center x, center y, width and height relative to the frame
+     * size), an objectness score and one confidence per class. Because the class confidences are never
+     * higher than the objectness, detections with a low objectness are rejected before looking at the
+     * classes. The best class is found with SIMD instructions, and its minimum confidence is read from a
+     * table built once from the objectDetection.minXxxConfidence settings.
+     *
+     * @author Marc Plouhinec
+     */
+    class YoloOutputDecoder {
+        private:
+            std::vector<model::DetectedObjectType> objectTypesByClassId;
+            std::vector<float> minConfidencesByClassId;
+            float minConfidence;
+
+        public:
+            YoloOutputDecoder(
+                const model::Configuration& configuration,
+                const std::vector<model::DetectedObjectType>& objectTypesByClassId);
+
+            virtual ~YoloOutputDecoder() {}
+
+            /**
+             * Decode the rows of a YOLO output layer, as returned by OpenCV DNN: each row contains
+             * [centerX, centerY, width, height, objectness, confidence of class 0, confidence of class 1...].
+             *
+             * @param pRows Pointer to the first row; rows must be contiguous.
+             * @param nbRows Number of rows.
+             * @param nbCols Number of values per row.
+             * @param frameSize Size of the frame, used to convert relative coordinates into pixels.
+             * @param detectedObjects Where the detected objects are added.
+             */
+            void decodeRows(
+                const float* pRows,
+                int nbRows,
+                int nbCols,
+                cv::Size frameSize,
+                std::vector<model::DetectedObject>& detectedObjects) const;
+
+            /**
+             * Decode one detection.
+             *
+             * @return true if the detection was accepted and added to detectedObjects.
+             */
+            bool decode(
+                float centerX,
+                float centerY,
+                float width,
+                float height,
+                float objectness,
+                const float* pClassConfidences,
+                int nbClasses,
+                cv::Size frameSize,
+                std::vector<model::DetectedObject>& detectedObjects) const;
+
+            float getMinConfidence() const {
+                return minConfidence;
+            }
+    };
+
+}
+
+#endif // UTILS_YOLO_OUTPUT_DECODER
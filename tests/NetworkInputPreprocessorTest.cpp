@@ -0,0 +1,57 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "src/utils/NetworkInputPreprocessor.hpp"
+
+using std::vector;
+
+static const float MAX_DIFFERENCE = 1e-4;
+
+/**
+ * Check that {@link utils::NetworkInputPreprocessor} produces the same tensor as cv::dnn::blobFromImages(),
+ * with frames that need to be resized, frames that already have the network input size and a cropped
+ * (non-continuous) frame.
+ *
+ * @author Marc Plouhinec
+ */
+static bool checkSameAsBlobFromImages(const vector<cv::Mat>& frames, cv::Size inputSize) {
+    const float scale = 1 / 255.0;
+    utils::NetworkInputPreprocessor networkInputPreprocessor(inputSize, scale);
+    const cv::Mat& tensor = networkInputPreprocessor.preprocess(frames);
+    cv::Mat expectedTensor = cv::dnn::blobFromImages(frames, scale, inputSize, cv::Scalar(), true, false);
+
+    if (tensor.size != expectedTensor.size || tensor.type() != expectedTensor.type()) {
+        std::cerr << "The tensor dimensions or type differ from cv::dnn::blobFromImages()." << std::endl;
+        return false;
+    }
+    double maxDifference = cv::norm(tensor.reshape(1, 1), expectedTensor.reshape(1, 1), cv::NORM_INF);
+    if (maxDifference > MAX_DIFFERENCE) {
+        std::cerr << "The tensor differs from cv::dnn::blobFromImages() by " << maxDifference
+            << " (input size = " << inputSize << ")." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    cv::RNG rng(42);
+    cv::Size inputSize(416, 256);
+
+    cv::Mat largeFrame(720, 1280, CV_8UC3);
+    cv::Mat smallFrame(180, 320, CV_8UC3);
+    cv::Mat sameSizeFrame(inputSize, CV_8UC3);
+    rng.fill(largeFrame, cv::RNG::UNIFORM, 0, 256);
+    rng.fill(smallFrame, cv::RNG::UNIFORM, 0, 256);
+    rng.fill(sameSizeFrame, cv::RNG::UNIFORM, 0, 256);
+    cv::Mat croppedFrame = largeFrame(cv::Rect(100, 50, 640, 480));
+
+    bool success = checkSameAsBlobFromImages({ largeFrame }, inputSize)
+        && checkSameAsBlobFromImages({ sameSizeFrame }, inputSize)
+        && checkSameAsBlobFromImages({ croppedFrame }, inputSize)
+        && checkSameAsBlobFromImages({ largeFrame, smallFrame, sameSizeFrame, croppedFrame }, inputSize);
+
+    std::cout << (success ? "NetworkInputPreprocessor matches cv::dnn::blobFromImages()." : "Test failed.")
+        << std::endl;
+    return success ? 0 : 1;
+}